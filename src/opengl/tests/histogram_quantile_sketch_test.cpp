@@ -0,0 +1,184 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * @file histogram_quantile_sketch_test.cpp
+ * @brief Program checking bin counts of histograms and quantiles of sketches (does not use OpenGL).
+ * @author tkornuta
+ * @Date:   18-10-2026
+ *
+ * Copyright (c) 2026, Tomasz Kornuta, IBM Corporation. All rights reserved.
+ *
+ */
+
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include <logger/Log.hpp>
+#include <logger/ConsoleOutput.hpp>
+using namespace mic::logger;
+
+#include <opengl/visualization/Histogram.hpp>
+#include <opengl/visualization/QuantileSketch.hpp>
+using namespace mic::opengl::visualization;
+
+/// Number of failed checks.
+size_t failures = 0;
+
+/*!
+ * \brief Checks the condition and logs the failure.
+ * \author tkornuta
+ * @param condition_ Checked condition.
+ * @param description_ Description of the check.
+ */
+void check(bool condition_, const char* description_) {
+	if (!condition_) {
+		LOG(LERROR) << "Check failed: " << description_;
+		failures++;
+	}//: if
+}
+
+/*!
+ * \brief Checks quantiles of the sketch - of a uniform sequence, after merge, with non-finite values and when empty.
+ * \author tkornuta
+ */
+void test_quantile_sketch (void) {
+	const float nan = std::numeric_limits<float>::quiet_NaN();
+	const float inf = std::numeric_limits<float>::infinity();
+
+	// Uniform sequence 0..9999.
+	QuantileSketch sketch;
+	for (size_t i = 0; i < 10000; i++)
+		sketch.add(i);
+	check(sketch.getCount() == 10000, "sketch count");
+	check((sketch.getMin() == 0) && (sketch.getMax() == 9999), "sketch min/max");
+	check(std::abs(sketch.quantile(0.5) - 4999.5) < 50, "sketch median");
+	check(std::abs(sketch.quantile(0.01) - 99.99) < 10, "sketch 1st percentile");
+	check(std::abs(sketch.quantile(0.99) - 9899.01) < 10, "sketch 99th percentile");
+
+	// Two halves merged.
+	QuantileSketch lower, upper;
+	for (size_t i = 0; i < 5000; i++) {
+		lower.add(i);
+		upper.add(i + 5000);
+	}//: for
+	lower.merge(upper);
+	check(lower.getCount() == 10000, "merged sketch count");
+	check((lower.getMin() == 0) && (lower.getMax() == 9999), "merged sketch min/max");
+	check(std::abs(lower.quantile(0.5) - 4999.5) < 50, "merged sketch median");
+	check(std::abs(lower.quantile(0.9) - 8999.1) < 50, "merged sketch 90th percentile");
+
+	// Non-finite values are ignored.
+	QuantileSketch finite;
+	finite.add(1.0);
+	finite.add(nan);
+	finite.add(inf);
+	finite.add(-inf);
+	finite.add(3.0);
+	check(finite.getCount() == 2, "non-finite values not counted by sketch");
+	check((finite.getMin() == 1.0) && (finite.getMax() == 3.0), "non-finite values not changing min/max");
+	check(std::isfinite(finite.quantile(0.5)), "sketch median finite");
+
+	// Empty sketch.
+	QuantileSketch empty;
+	empty.add(nan);
+	check(empty.getCount() == 0, "empty sketch count");
+	check(empty.quantile(0.5) == 0, "empty sketch median");
+}
+
+/*!
+ * \brief Checks bin counts of the histogram - with adaptive and fixed edges, of data spanning many chunks and with non-finite values.
+ * \author tkornuta
+ */
+void test_histogram (void) {
+	const float nan = std::numeric_limits<float>::quiet_NaN();
+	const float inf = std::numeric_limits<float>::infinity();
+
+	// Values 0, 1, 2, 3 repeated - adaptive edges, one value per bin.
+	std::vector<float> data(1000);
+	for (size_t i = 0; i < data.size(); i++)
+		data[i] = i % 4;
+	Histogram<float> histogram(4);
+	histogram.compute(data.data(), data.size());
+	check((histogram.getMin() == 0) && (histogram.getMax() == 3), "adaptive edges");
+	for (size_t b = 0; b < 4; b++)
+		check(histogram.getCounts()[b] == 250, "adaptive bin count");
+	check(histogram.getNonFiniteCount() == 0, "adaptive non-finite count");
+
+	// Fixed edges [-1, 1] - values 2 and 3 are clamped to the last bin.
+	histogram.compute(data.data(), data.size(), -1.0f, 1.0f);
+	check((histogram.getCounts()[0] == 0) && (histogram.getCounts()[1] == 0), "fixed lower bin counts");
+	check(histogram.getCounts()[2] == 250, "fixed value 0 bin count");
+	check(histogram.getCounts()[3] == 750, "fixed clamped bin count");
+
+	// Data spanning many chunks and blocks.
+	std::vector<float> large(1000003);
+	for (size_t i = 0; i < large.size(); i++)
+		large[i] = i % 4;
+	histogram.compute(large.data(), large.size());
+	size_t total = 0;
+	for (size_t b = 0; b < 4; b++)
+		total += histogram.getCounts()[b];
+	check(total == large.size(), "large data total count");
+	check(histogram.getCounts()[0] == 250001, "large data first bin count");
+	check(histogram.getCounts()[3] == 250000, "large data last bin count");
+
+	// Non-finite values - counted separately, not influencing the edges.
+	data[0] = nan;
+	data[1] = inf;
+	data[2] = -inf;
+	histogram.compute(data.data(), data.size());
+	check(histogram.getNonFiniteCount() == 3, "non-finite count");
+	check((histogram.getMin() == 0) && (histogram.getMax() == 3), "edges of finite values");
+	total = 0;
+	for (size_t b = 0; b < 4; b++)
+		total += histogram.getCounts()[b];
+	check(total == data.size() - 3, "finite values total count");
+	histogram.compute(data.data(), data.size(), -1.0f, 1.0f);
+	check(histogram.getNonFiniteCount() == 3, "fixed edges non-finite count");
+
+	// Only non-finite values.
+	std::vector<float> nans(100, nan);
+	histogram.compute(nans.data(), nans.size());
+	check(histogram.getNonFiniteCount() == 100, "all non-finite count");
+	check((histogram.getMin() == 0) && (histogram.getMax() == 0), "all non-finite edges");
+	for (size_t b = 0; b < 4; b++)
+		check(histogram.getCounts()[b] == 0, "all non-finite bin count");
+}
+
+
+/*!
+ * \brief Main program function. Runs the checks, returns the number of failed ones.
+ * \author tkornuta
+ * @param[in] argc Number of parameters (not used).
+ * @param[in] argv List of parameters (not used).
+ * @return Zero if all checks passed.
+ */
+int main(int argc, char* argv[]) {
+	// Set console output to logger.
+	LOGGER->addOutput(new ConsoleOutput());
+
+	test_quantile_sketch();
+	test_histogram();
+
+	if (failures > 0) {
+		LOG(LERROR) << failures << " checks failed";
+		return 1;
+	}//: if
+	LOG(LINFO) << "All checks passed";
+	return 0;
+}//: main
@@ -0,0 +1,125 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * @file window_confusion_matrix_test.cpp
+ * @brief Program for testing visualization of confusion matrices filled by multiple threads.
+ * @author tkornuta
+ * @Date:   18-10-2026
+ *
+ * Copyright (c) 2026, Tomasz Kornuta, IBM Corporation. All rights reserved.
+ *
+ */
+
+
+#include <boost/thread/thread.hpp>
+#include <boost/bind.hpp>
+
+#include <cstdlib>
+#include <vector>
+
+#include <logger/Log.hpp>
+#include <logger/ConsoleOutput.hpp>
+using namespace mic::logger;
+
+#include <opengl/visualization/WindowManager.hpp>
+#include <opengl/visualization/WindowConfusionMatrix.hpp>
+using namespace mic::opengl::visualization;
+
+/// Window displaying the confusion matrix.
+WindowConfusionMatrix* w_confusion;
+
+/*!
+ * \brief Function testing a part of the test set - adds label/prediction pairs to the accumulator of the calling thread.
+ * \author tkornuta
+ * @param accuracy_ Ratio of correct predictions.
+ */
+void test_part_body (float accuracy_) {
+	std::vector<size_t> labels(250), predictions(250);
+	for (size_t i = 0; i < labels.size(); i++) {
+		labels[i] = rand() % 100;
+		// Incorrect predictions are confused with the neighbouring classes.
+		predictions[i] = ((float)rand() / RAND_MAX < accuracy_) ? labels[i] : (labels[i] + 1 + rand() % 3) % 100;
+	}//: for
+	w_confusion->addPredictions(labels, predictions);
+}
+
+/*!
+ * \brief Function generating data and passing it to the window.
+ * \author tkornuta
+ */
+void test_thread_body (void) {
+
+	size_t step = 0;
+
+ 	// Main application loop.
+	while (!APP_STATE->Quit()) {
+
+		// If not paused.
+		if (!APP_STATE->isPaused()) {
+
+			// If single step mode - pause after the step.
+			if (APP_STATE->isSingleStepModeOn())
+				APP_STATE->pressPause();
+
+			// Test the whole set with four threads (pairs are added without locking).
+			float accuracy = 1.0f - 0.9f / (1.0f + 0.01f * step);
+			boost::thread_group testing_threads;
+			for (size_t i = 0; i < 4; i++)
+				testing_threads.create_thread(boost::bind(&test_part_body, accuracy));
+			testing_threads.join_all();
+			step++;
+
+			// Merge pairs and display the matrix.
+			w_confusion->publishSynchronized();
+
+		}//: if
+
+		// Sleep.
+		APP_SLEEP();
+	}//: while
+
+}//: test_thread_body
+
+
+
+/*!
+ * \brief Main program function. Runs two threads: main (for GLUT) and another one (for data processing).
+ * \author tkornuta
+ * @param[in] argc Number of parameters (not used).
+ * @param[in] argv List of parameters (not used).
+ * @return (not used)
+ */
+int main(int argc, char* argv[]) {
+	// Set console output to logger.
+	LOGGER->addOutput(new ConsoleOutput());
+	LOG(LINFO) << "Logger initialized. Starting application";
+
+	// Initialize GLUT! :]
+	VGL_MANAGER->initializeGLUT(argc, argv);
+
+	// Create visualization window.
+	w_confusion = new WindowConfusionMatrix("Confusion matrix", 0, 0, 512, 512, 100);
+
+	boost::thread test_thread(boost::bind(&test_thread_body));
+
+	// Start visualization thread.
+	VGL_MANAGER->startVisualizationLoop();
+
+	LOG(LINFO) << "Waiting for threads to join...";
+	// End test thread.
+	test_thread.join();
+	LOG(LINFO) << "Threads joined - ending application";
+}//: main
@@ -0,0 +1,118 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * @file window_histogram_test.cpp
+ * @brief Program for testing histogram visualization.
+ * @author tkornuta
+ * @Date:   18-10-2026
+ *
+ * Copyright (c) 2026, Tomasz Kornuta, IBM Corporation. All rights reserved.
+ *
+ */
+
+
+#include <boost/thread/thread.hpp>
+#include <boost/bind.hpp>
+
+#include <limits>
+
+#include <types/MatrixTypes.hpp>
+
+#include <logger/Log.hpp>
+#include <logger/ConsoleOutput.hpp>
+using namespace mic::logger;
+
+#include <opengl/visualization/WindowManager.hpp>
+#include <opengl/visualization/WindowHistogram.hpp>
+using namespace mic::opengl::visualization;
+
+/// Window displaying the histogram.
+WindowHistogram<float>* w_histogram;
+
+/*!
+ * \brief Function generating data and passing it to the window.
+ * \author tkornuta
+ */
+void test_thread_body (void) {
+
+	// Values - 1000 x 1000 elements.
+	mic::types::MatrixXfPtr values (new mic::types::MatrixXf(1000, 1000));
+	size_t step = 0;
+
+ 	// Main application loop.
+	while (!APP_STATE->Quit()) {
+
+		// If not paused.
+		if (!APP_STATE->isPaused()) {
+
+			// If single step mode - pause after the step.
+			if (APP_STATE->isSingleStepModeOn())
+				APP_STATE->pressPause();
+
+			{ // Enter critical section - with the use of scoped lock from AppState!
+				APP_DATA_SYNCHRONIZATION_SCOPED_LOCK();
+
+				// Sum of uniform distributions (roughly normal), with the mean drifting in time.
+				values->setRandom();
+				*values += mic::types::MatrixXf::Random(1000, 1000) + mic::types::MatrixXf::Constant(1000, 1000, 0.01f * (step % 100));
+				// A few non-finite values (counted, but not binned).
+				(*values)(0) = std::numeric_limits<float>::quiet_NaN();
+				(*values)(1) = std::numeric_limits<float>::infinity();
+				(*values)(2) = -std::numeric_limits<float>::infinity();
+				step++;
+
+				// Set values to be displayed.
+				w_histogram->setDataPointerUnsynchronized(values);
+			}//: end of critical section
+
+		}//: if
+
+		// Sleep.
+		APP_SLEEP();
+	}//: while
+
+}//: test_thread_body
+
+
+
+/*!
+ * \brief Main program function. Runs two threads: main (for GLUT) and another one (for data processing).
+ * \author tkornuta
+ * @param[in] argc Number of parameters (not used).
+ * @param[in] argv List of parameters (not used).
+ * @return (not used)
+ */
+int main(int argc, char* argv[]) {
+	// Set console output to logger.
+	LOGGER->addOutput(new ConsoleOutput());
+	LOG(LINFO) << "Logger initialized. Starting application";
+
+	// Initialize GLUT! :]
+	VGL_MANAGER->initializeGLUT(argc, argv);
+
+	// Create visualization window.
+	w_histogram = new WindowHistogram<float>("Histogram", 0, 0, 512, 512, 64, 128);
+
+	boost::thread test_thread(boost::bind(&test_thread_body));
+
+	// Start visualization thread.
+	VGL_MANAGER->startVisualizationLoop();
+
+	LOG(LINFO) << "Waiting for threads to join...";
+	// End test thread.
+	test_thread.join();
+	LOG(LINFO) << "Threads joined - ending application";
+}//: main
@@ -0,0 +1,128 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * @file window_saliency_overlay_test.cpp
+ * @brief Program for testing visualization of saliency maps overlaid on images.
+ * @author tkornuta
+ * @Date:   18-10-2026
+ *
+ * Copyright (c) 2026, Tomasz Kornuta, IBM Corporation. All rights reserved.
+ *
+ */
+
+
+#include <boost/thread/thread.hpp>
+#include <boost/bind.hpp>
+
+#include <cmath>
+
+#include <types/MatrixTypes.hpp>
+#include <types/TensorTypes.hpp>
+
+#include <logger/Log.hpp>
+#include <logger/ConsoleOutput.hpp>
+using namespace mic::logger;
+
+#include <opengl/visualization/WindowManager.hpp>
+#include <opengl/visualization/WindowSaliencyOverlay.hpp>
+using namespace mic::opengl::visualization;
+
+/// Window displaying the image and the saliency.
+WindowSaliencyOverlay<float>* w_saliency;
+
+/*!
+ * \brief Function generating data and passing it to the window.
+ * \author tkornuta
+ */
+void test_thread_body (void) {
+
+	// Image - 128 x 128 RGB gradient (planar channels).
+	size_t height = 128, width = 128;
+	mic::types::TensorXfPtr image (new mic::types::Tensor<float>({height, width, 3}));
+	float* pixels = image->data();
+	for (size_t y = 0; y < height; y++)
+		for (size_t x = 0; x < width; x++) {
+			pixels[y * width + x] = (float)x / width;
+			pixels[height * width + y * width + x] = (float)y / height;
+			pixels[2 * height * width + y * width + x] = 0.5f;
+		}//: for
+	size_t step = 0;
+
+ 	// Main application loop.
+	while (!APP_STATE->Quit()) {
+
+		// If not paused.
+		if (!APP_STATE->isPaused()) {
+
+			// If single step mode - pause after the step.
+			if (APP_STATE->isSingleStepModeOn())
+				APP_STATE->pressPause();
+
+			{ // Enter critical section - with the use of scoped lock from AppState!
+				APP_DATA_SYNCHRONIZATION_SCOPED_LOCK();
+
+				// Low resolution saliency - blob circling around the centre of the image.
+				mic::types::MatrixXfPtr saliency (new mic::types::MatrixXf(16, 16));
+				float cx = 8.0f + 5.0f * std::cos(0.05f * step);
+				float cy = 8.0f + 5.0f * std::sin(0.05f * step);
+				for (size_t col = 0; col < 16; col++)
+					for (size_t row = 0; row < 16; row++)
+						(*saliency)(row, col) = std::exp(-0.1f * (((float)col - cx) * ((float)col - cx) + ((float)row - cy) * ((float)row - cy)));
+				step++;
+
+				// Set image and saliency to be displayed.
+				w_saliency->setImagePointerUnsynchronized(image);
+				w_saliency->setSaliencyPointerUnsynchronized(saliency);
+			}//: end of critical section
+
+		}//: if
+
+		// Sleep.
+		APP_SLEEP();
+	}//: while
+
+}//: test_thread_body
+
+
+
+/*!
+ * \brief Main program function. Runs two threads: main (for GLUT) and another one (for data processing).
+ * \author tkornuta
+ * @param[in] argc Number of parameters (not used).
+ * @param[in] argv List of parameters (not used).
+ * @return (not used)
+ */
+int main(int argc, char* argv[]) {
+	// Set console output to logger.
+	LOGGER->addOutput(new ConsoleOutput());
+	LOG(LINFO) << "Logger initialized. Starting application";
+
+	// Initialize GLUT! :]
+	VGL_MANAGER->initializeGLUT(argc, argv);
+
+	// Create visualization window.
+	w_saliency = new WindowSaliencyOverlay<float>("Saliency", 0, 0, 512, 512);
+
+	boost::thread test_thread(boost::bind(&test_thread_body));
+
+	// Start visualization thread.
+	VGL_MANAGER->startVisualizationLoop();
+
+	LOG(LINFO) << "Waiting for threads to join...";
+	// End test thread.
+	test_thread.join();
+	LOG(LINFO) << "Threads joined - ending application";
+}//: main
@@ -0,0 +1,128 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * @file window_scatter_test.cpp
+ * @brief Program for testing visualization of large sets of 2D points.
+ * @author tkornuta
+ * @Date:   18-10-2026
+ *
+ * Copyright (c) 2026, Tomasz Kornuta, IBM Corporation. All rights reserved.
+ *
+ */
+
+
+#include <boost/thread/thread.hpp>
+#include <boost/bind.hpp>
+
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include <types/MatrixTypes.hpp>
+
+#include <logger/Log.hpp>
+#include <logger/ConsoleOutput.hpp>
+using namespace mic::logger;
+
+#include <opengl/visualization/WindowManager.hpp>
+#include <opengl/visualization/WindowScatter.hpp>
+using namespace mic::opengl::visualization;
+
+/// Window displaying the points.
+WindowScatter<float>* w_scatter;
+
+/*!
+ * \brief Function generating data and passing it to the window.
+ * \author tkornuta
+ */
+void test_thread_body (void) {
+
+	// Points - 100000 points in ten clusters.
+	size_t number_of_points = 100000;
+	mic::types::MatrixXfPtr noise (new mic::types::MatrixXf(number_of_points, 2));
+	noise->setRandom();
+	std::shared_ptr<std::vector<size_t> > labels = std::make_shared<std::vector<size_t> >(number_of_points);
+	for (size_t i = 0; i < number_of_points; i++)
+		(*labels)[i] = i % 10;
+	size_t step = 0;
+
+ 	// Main application loop.
+	while (!APP_STATE->Quit()) {
+
+		// If not paused.
+		if (!APP_STATE->isPaused()) {
+
+			// If single step mode - pause after the step.
+			if (APP_STATE->isSingleStepModeOn())
+				APP_STATE->pressPause();
+
+			{ // Enter critical section - with the use of scoped lock from AppState!
+				APP_DATA_SYNCHRONIZATION_SCOPED_LOCK();
+
+				// Clusters rotating around the origin.
+				mic::types::MatrixXfPtr points (new mic::types::MatrixXf(number_of_points, 2));
+				for (size_t i = 0; i < number_of_points; i++) {
+					float angle = 0.628f * (*labels)[i] + 0.01f * step;
+					(*points)(i, 0) = 5.0f * std::cos(angle) + (*noise)(i, 0);
+					(*points)(i, 1) = 5.0f * std::sin(angle) + (*noise)(i, 1);
+				}//: for
+				// A point with non-finite coordinates (dropped by the window).
+				(*points)(0, 0) = std::numeric_limits<float>::quiet_NaN();
+				step++;
+
+				// Set points to be displayed.
+				w_scatter->setDataPointerUnsynchronized(points, labels);
+			}//: end of critical section
+
+		}//: if
+
+		// Sleep.
+		APP_SLEEP();
+	}//: while
+
+}//: test_thread_body
+
+
+
+/*!
+ * \brief Main program function. Runs two threads: main (for GLUT) and another one (for data processing).
+ * \author tkornuta
+ * @param[in] argc Number of parameters (not used).
+ * @param[in] argv List of parameters (not used).
+ * @return (not used)
+ */
+int main(int argc, char* argv[]) {
+	// Set console output to logger.
+	LOGGER->addOutput(new ConsoleOutput());
+	LOG(LINFO) << "Logger initialized. Starting application";
+
+	// Initialize GLUT! :]
+	VGL_MANAGER->initializeGLUT(argc, argv);
+
+	// Create visualization window.
+	w_scatter = new WindowScatter<float>("Scatter", 0, 0, 512, 512);
+
+	boost::thread test_thread(boost::bind(&test_thread_body));
+
+	// Start visualization thread.
+	VGL_MANAGER->startVisualizationLoop();
+
+	LOG(LINFO) << "Waiting for threads to join...";
+	// End test thread.
+	test_thread.join();
+	LOG(LINFO) << "Threads joined - ending application";
+}//: main
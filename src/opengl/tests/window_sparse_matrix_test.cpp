@@ -0,0 +1,116 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * @file window_sparse_matrix_test.cpp
+ * @brief Program for testing visualization of large sparse matrices.
+ * @author tkornuta
+ * @Date:   18-10-2026
+ *
+ * Copyright (c) 2026, Tomasz Kornuta, IBM Corporation. All rights reserved.
+ *
+ */
+
+
+#include <boost/thread/thread.hpp>
+#include <boost/bind.hpp>
+
+#include <cstdlib>
+#include <vector>
+
+#include <logger/Log.hpp>
+#include <logger/ConsoleOutput.hpp>
+using namespace mic::logger;
+
+#include <opengl/visualization/WindowManager.hpp>
+#include <opengl/visualization/WindowSparseMatrix.hpp>
+using namespace mic::opengl::visualization;
+
+/// Window displaying the sparse matrix.
+WindowSparseMatrix<float>* w_sparse;
+
+/*!
+ * \brief Function generating data and passing it to the window.
+ * \author tkornuta
+ */
+void test_thread_body (void) {
+
+	// Sparse matrix - 10000 x 10000 elements, band around the diagonal and random entries.
+	WindowSparseMatrix<float>::SparseMatrixPtr matrix = std::make_shared<WindowSparseMatrix<float>::SparseMatrix>(10000, 10000);
+	std::vector<Eigen::Triplet<float> > triplets;
+
+ 	// Main application loop.
+	while (!APP_STATE->Quit()) {
+
+		// If not paused.
+		if (!APP_STATE->isPaused()) {
+
+			// If single step mode - pause after the step.
+			if (APP_STATE->isSingleStepModeOn())
+				APP_STATE->pressPause();
+
+			{ // Enter critical section - with the use of scoped lock from AppState!
+				APP_DATA_SYNCHRONIZATION_SCOPED_LOCK();
+
+				// Generate entries.
+				triplets.clear();
+				for (int i = 0; i < 10000; i++)
+					triplets.push_back(Eigen::Triplet<float>(i, std::min(9999, i + rand() % 50), 1.0f));
+				for (int i = 0; i < 50000; i++)
+					triplets.push_back(Eigen::Triplet<float>(rand() % 10000, rand() % 10000, (float)(rand() % 200 - 100) / 100.0f));
+				matrix->setFromTriplets(triplets.begin(), triplets.end());
+
+				// Set matrix to be displayed.
+				w_sparse->setMatrixPointerUnsynchronized(matrix);
+			}//: end of critical section
+
+		}//: if
+
+		// Sleep.
+		APP_SLEEP();
+	}//: while
+
+}//: test_thread_body
+
+
+
+/*!
+ * \brief Main program function. Runs two threads: main (for GLUT) and another one (for data processing).
+ * \author tkornuta
+ * @param[in] argc Number of parameters (not used).
+ * @param[in] argv List of parameters (not used).
+ * @return (not used)
+ */
+int main(int argc, char* argv[]) {
+	// Set console output to logger.
+	LOGGER->addOutput(new ConsoleOutput());
+	LOG(LINFO) << "Logger initialized. Starting application";
+
+	// Initialize GLUT! :]
+	VGL_MANAGER->initializeGLUT(argc, argv);
+
+	// Create visualization window.
+	w_sparse = new WindowSparseMatrix<float>("Sparse matrix", 0, 0, 512, 512);
+
+	boost::thread test_thread(boost::bind(&test_thread_body));
+
+	// Start visualization thread.
+	VGL_MANAGER->startVisualizationLoop();
+
+	LOG(LINFO) << "Waiting for threads to join...";
+	// End test thread.
+	test_thread.join();
+	LOG(LINFO) << "Threads joined - ending application";
+}//: main
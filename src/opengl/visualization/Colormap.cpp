@@ -0,0 +1,147 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file Colormap.cpp
+ * \brief Contains definition of a class storing precomputed colormap lookup tables.
+ * \author tkornuta
+ * \date Oct 18, 2026
+ */
+
+#include <opengl/visualization/Colormap.hpp>
+
+#include <cstring>
+
+namespace mic {
+namespace opengl {
+namespace visualization {
+
+namespace {
+
+/// Viridis sampled at 0.0, 0.1, ..., 1.0.
+const float viridis_stops[][3] = {
+	{0.267f, 0.005f, 0.329f}, {0.283f, 0.141f, 0.458f}, {0.254f, 0.265f, 0.530f}, {0.207f, 0.372f, 0.553f},
+	{0.164f, 0.471f, 0.558f}, {0.128f, 0.567f, 0.551f}, {0.135f, 0.659f, 0.518f}, {0.267f, 0.749f, 0.441f},
+	{0.478f, 0.821f, 0.318f}, {0.741f, 0.873f, 0.150f}, {0.993f, 0.906f, 0.144f}
+};
+
+/// Magma sampled at 0.0, 0.1, ..., 1.0.
+const float magma_stops[][3] = {
+	{0.001f, 0.000f, 0.014f}, {0.079f, 0.054f, 0.211f}, {0.232f, 0.060f, 0.437f}, {0.390f, 0.100f, 0.502f},
+	{0.550f, 0.161f, 0.506f}, {0.716f, 0.215f, 0.475f}, {0.868f, 0.288f, 0.409f}, {0.967f, 0.439f, 0.360f},
+	{0.994f, 0.624f, 0.427f}, {0.995f, 0.812f, 0.573f}, {0.987f, 0.991f, 0.750f}
+};
+
+/// Diverging blue-white-red.
+const float diverging_stops[][3] = {
+	{0.019f, 0.188f, 0.380f}, {0.263f, 0.576f, 0.765f}, {0.969f, 0.969f, 0.969f}, {0.839f, 0.376f, 0.302f},
+	{0.404f, 0.000f, 0.122f}
+};
+
+/// Ten categorical colours (the original digit colours of the maze of digits).
+const float categorical_colors[][3] = {
+	{0.0f, 0.0f, 0.3f}, {0.0f, 0.0f, 0.6f}, {0.0f, 0.0f, 0.9f}, {0.0f, 0.3f, 1.0f}, {0.0f, 0.6f, 0.6f},
+	{0.0f, 0.9f, 0.3f}, {1.0f, 0.75f, 0.0f}, {1.0f, 0.5f, 0.0f}, {1.0f, 0.25f, 0.0f}, {1.0f, 1.0f, 1.0f}
+};
+
+/// Black-white ramp.
+const float grayscale_stops[][3] = {
+	{0.0f, 0.0f, 0.0f}, {1.0f, 1.0f, 1.0f}
+};
+
+} //: namespace
+
+Colormap::Colormap(ColormapType type_, size_t entries_) :
+		type(type_), entries(entries_)
+{
+	setType(type_);
+}
+
+void Colormap::setType(ColormapType type_) {
+	type = type_;
+	switch(type) {
+	case Colormap_Viridis:
+		interpolate(viridis_stops, 11, entries);
+		break;
+	case Colormap_Magma:
+		interpolate(magma_stops, 11, entries);
+		break;
+	case Colormap_Diverging:
+		interpolate(diverging_stops, 5, entries);
+		break;
+	case Colormap_Categorical:
+		lut.resize(10);
+		for (size_t i = 0; i < 10; i++)
+			lut[i] = pack(categorical_colors[i][0], categorical_colors[i][1], categorical_colors[i][2]);
+		break;
+	// Grayscale ramp is default.
+	case Colormap_None:
+	default:
+		interpolate(grayscale_stops, 2, entries);
+		break;
+	}//: switch
+}
+
+void Colormap::interpolate(const float (*stops_)[3], size_t count_, size_t entries_) {
+	lut.resize(entries_);
+	for (size_t i = 0; i < entries_; i++) {
+		// Position of the entry between the control colours.
+		float pos = (entries_ > 1) ? (float)i * (count_ - 1) / (entries_ - 1) : 0.0f;
+		size_t s = std::min((size_t)pos, count_ - 2);
+		float t = pos - s;
+		lut[i] = pack(stops_[s][0] + t * (stops_[s+1][0] - stops_[s][0]),
+				stops_[s][1] + t * (stops_[s+1][1] - stops_[s][1]),
+				stops_[s][2] + t * (stops_[s+1][2] - stops_[s][2]));
+	}//: for
+}
+
+uint32_t Colormap::pack(float r_, float g_, float b_) {
+	uint8_t bytes[4] = {
+			(uint8_t)(std::min(std::max(r_, 0.0f), 1.0f) * 255.0f + 0.5f),
+			(uint8_t)(std::min(std::max(g_, 0.0f), 1.0f) * 255.0f + 0.5f),
+			(uint8_t)(std::min(std::max(b_, 0.0f), 1.0f) * 255.0f + 0.5f),
+			255 };
+	uint32_t rgba;
+	memcpy(&rgba, bytes, sizeof(rgba));
+	return rgba;
+}
+
+void Colormap::unpack(uint32_t rgba_, float & r_, float & g_, float & b_) {
+	uint8_t bytes[4];
+	memcpy(bytes, &rgba_, sizeof(rgba_));
+	r_ = bytes[0] / 255.0f;
+	g_ = bytes[1] / 255.0f;
+	b_ = bytes[2] / 255.0f;
+}
+
+std::string Colormap::colormap2str(ColormapType type_) {
+	switch(type_) {
+	case Colormap_Viridis:
+		return "Display values using the viridis colormap";
+	case Colormap_Magma:
+		return "Display values using the magma colormap";
+	case Colormap_Diverging:
+		return "Display values using the diverging blue-white-red colormap, symmetric around zero";
+	case Colormap_Categorical:
+		return "Display values using ten categorical colours";
+	case Colormap_None:
+	default:
+		return "Display values coloured according to the normalization mode";
+	}//: switch
+}
+
+} /* namespace visualization */
+} /* namespace opengl */
+} /* namespace mic */
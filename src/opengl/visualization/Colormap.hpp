@@ -0,0 +1,172 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file Colormap.hpp
+ * \brief Contains declaration of a class storing precomputed colormap lookup tables.
+ * \author tkornuta
+ * \date Oct 18, 2026
+ */
+
+#ifndef SRC_OPENGL_VISUALIZATION_COLORMAP_HPP_
+#define SRC_OPENGL_VISUALIZATION_COLORMAP_HPP_
+
+#include <Eigen/Core>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace mic {
+namespace opengl {
+namespace visualization {
+
+/*!
+ * \brief Enumerator defining available colormaps.
+ * \author tkornuta
+ */
+enum ColormapType {
+	Colormap_None = 0, ///< No colormap - data is coloured according to the normalization mode
+	Colormap_Viridis, ///< Perceptually uniform blue-green-yellow colormap
+	Colormap_Magma, ///< Perceptually uniform black-purple-orange-white colormap
+	Colormap_Diverging, ///< Blue-white-red colormap, symmetric around zero
+	Colormap_Categorical, ///< Ten distinct colours (e.g. for digits or labels)
+	Colormap_Count ///< Number of colormaps (used for toggling)
+};
+
+/*!
+ * \brief Class storing a precomputed colormap lookup table and applying it to whole buffers.
+ *
+ * Colours are stored as packed RGBA8 values (bytes in R, G, B, A order in memory), so the result can be directly uploaded to a texture.
+ * Values are quantized in a vectorized (Eigen) pass and then gathered from the table - there are no per-value branches.
+ * \author tkornuta
+ */
+class Colormap {
+public:
+	/*!
+	 * Constructor. Builds the lookup table.
+	 * @param type_ Type of the colormap.
+	 * @param entries_ Number of entries of continuous colormaps (e.g. 256 or 4096). Categorical colormap has always 10 entries.
+	 */
+	Colormap(ColormapType type_ = Colormap_None, size_t entries_ = 256);
+
+	/*!
+	 * Changes type of the colormap, rebuilding the lookup table.
+	 * @param type_ Type of the colormap.
+	 */
+	void setType(ColormapType type_);
+
+	/*!
+	 * Returns type of the colormap.
+	 */
+	ColormapType getType() const { return type; }
+
+	/*!
+	 * Returns number of entries in the lookup table.
+	 */
+	size_t getEntries() const { return lut.size(); }
+
+	/*!
+	 * Returns colour stored in a given entry of the lookup table.
+	 * @param index_ Index of the entry (wrapped around the size of the table).
+	 */
+	uint32_t color(size_t index_) const { return lut[index_ % lut.size()]; }
+
+	/*!
+	 * Packs float colour components (clamped to <0,1>) into RGBA8 colour (opaque).
+	 * @param r_ Red component.
+	 * @param g_ Green component.
+	 * @param b_ Blue component.
+	 * @return Packed colour.
+	 */
+	static uint32_t pack(float r_, float g_, float b_);
+
+	/*!
+	 * Unpacks RGBA8 colour into float components.
+	 * @param rgba_ Packed colour.
+	 * @param r_ Red component.
+	 * @param g_ Green component.
+	 * @param b_ Blue component.
+	 */
+	static void unpack(uint32_t rgba_, float & r_, float & g_, float & b_);
+
+	/*!
+	 * Returns name of a given colormap.
+	 * @param type_ Type of the colormap.
+	 */
+	static std::string colormap2str(ColormapType type_);
+
+	/*!
+	 * Colours a buffer of values. Values from [min, max] are mapped to the consecutive entries of the table, values outside of the range (including infinities) are clamped, NaNs are mapped to the first entry.
+	 * Diverging colormap uses range symmetric around zero, so zero is always white.
+	 * Can be called concurrently (e.g. for different parts of a buffer).
+	 * @param data_ Pointer to the values.
+	 * @param size_ Number of values.
+	 * @param min_ Min value.
+	 * @param max_ Max value.
+	 * @param rgba_ Output buffer (at least size_ elements).
+	 */
+	template<typename eT>
+	void apply(const eT* data_, size_t size_, eT min_, eT max_, uint32_t* rgba_) const {
+		float min = (float)min_;
+		float max = (float)max_;
+		// Non-finite range (e.g. computed from data containing inf) - all values are mapped to the first entry.
+		if (!std::isfinite(min) || !std::isfinite(max))
+			min = max = 0.0f;
+		if (type == Colormap_Diverging) {
+			max = std::max(std::abs(min), std::abs(max));
+			min = -max;
+		}//: if
+		float scale = (max > min) ? (float)lut.size() / (max - min) : 0.0f;
+
+		// Quantize - vectorized by Eigen. NaNs are mapped to the first entry and infinities are clamped, so indices never leave the table.
+		Eigen::Map<const Eigen::Array<eT, Eigen::Dynamic, 1> > values(data_, size_);
+		Eigen::ArrayXf positions = (values.template cast<float>() - min) * scale;
+		Eigen::ArrayXi indices = positions.isNaN().select(0.0f, positions).max(0.0f).min((float)(lut.size() - 1)).template cast<int>();
+
+		// Gather.
+		const uint32_t* lut_ptr = lut.data();
+		const int* indices_ptr = indices.data();
+		for (size_t i = 0; i < size_; i++)
+			rgba_[i] = lut_ptr[indices_ptr[i]];
+	}
+
+private:
+	/*!
+	 * Fills the lookup table by linear interpolation between equally spaced control colours.
+	 * @param stops_ Control colours (RGB triples).
+	 * @param count_ Number of control colours.
+	 * @param entries_ Number of entries of the table.
+	 */
+	void interpolate(const float (*stops_)[3], size_t count_, size_t entries_);
+
+	/// Type of the colormap.
+	ColormapType type;
+
+	/// Number of entries of continuous colormaps.
+	size_t entries;
+
+	/// Lookup table.
+	std::vector<uint32_t> lut;
+};
+
+} /* namespace visualization */
+} /* namespace opengl */
+} /* namespace mic */
+
+#endif /* SRC_OPENGL_VISUALIZATION_COLORMAP_HPP_ */
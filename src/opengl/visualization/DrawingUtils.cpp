@@ -30,6 +30,17 @@ namespace mic {
   namespace opengl {
     namespace visualization {
 
+      DrawingUtils::DrawingUtils() :
+        viewport_width(0), viewport_height(0), viewport_revision(0) {
+      }
+
+      void DrawingUtils::setViewport(GLint width_, GLint height_) {
+        viewport_width = width_;
+        viewport_height = height_;
+        // Invalidate all layout-dependent data.
+        viewport_revision++;
+      }
+
       /*void DrawingUtils::display_image_roi(image* img, unsigned w, unsigned h, int x1, int y1, int x2, int y2, float r, float g, float b, float a) {
 
         if (img != NULL) {
@@ -144,31 +155,39 @@ namespace mic {
 
       void DrawingUtils::draw_grid(float r, float g, float b, float a, float cells_h, float cells_v, float line_width_) {
 
-        GLint h = glutGet(GLUT_WINDOW_HEIGHT);
-        GLint w = glutGet(GLUT_WINDOW_WIDTH);
-
-        float scale_x = (float) w / (float) (cells_h);
-        float scale_y = (float) h / (float) (cells_v);
-
-        glColor4f(r, g, b, a);
-        glLineWidth(line_width_);
-        glBegin(GL_LINES);
+        // Recompute vertices only when the viewport (or the number of cells) has changed.
+        GridVertices & grid = grid_cache[std::make_pair(cells_h, cells_v)];
+        if ((grid.revision != viewport_revision) || (grid.vertices.empty())) {
+          GLint h = viewport_height;
+          GLint w = viewport_width;
 
-        for (unsigned i = 1; i < cells_h; i++) {
+          float scale_x = (float) w / (float) (cells_h);
+          float scale_y = (float) h / (float) (cells_v);
 
-          glVertex2i((int) ((float) i * scale_x), 0);
-          glVertex2i((int) ((float) i * scale_x), (GLint) h);
+          grid.vertices.clear();
+          for (unsigned i = 1; i < cells_h; i++) {
+            GLint x = (int) ((float) i * scale_x);
+            grid.vertices.insert(grid.vertices.end(), {x, 0, x, h});
+          }
 
+          for (unsigned i = 1; i < cells_v; i++) {
+            GLint y = (int) ((float) i * scale_y);
+            grid.vertices.insert(grid.vertices.end(), {0, y, w, y});
+          }
+          grid.revision = viewport_revision;
         }
 
-        for (unsigned i = 1; i < cells_v; i++) {
-
-          glVertex2i(0, (int) ((float) i * scale_y));
-          glVertex2i((GLint) w, (int) ((float) i * scale_y));
+        if (grid.vertices.empty())
+          return;
 
-        }
+        glColor4f(r, g, b, a);
+        glLineWidth(line_width_);
 
-        glEnd();
+        // Draw all lines with a single call.
+        glEnableClientState(GL_VERTEX_ARRAY);
+        glVertexPointer(2, GL_INT, 0, grid.vertices.data());
+        glDrawArrays(GL_LINES, 0, (GLsizei) (grid.vertices.size() / 2));
+        glDisableClientState(GL_VERTEX_ARRAY);
       }
 
       void DrawingUtils::draw_mark(mark m, float x, float y, float size, float line_width, float r, float g, float b, float a) {
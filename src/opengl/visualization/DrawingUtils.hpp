@@ -37,9 +37,16 @@
 #include <windows.h>
 #include <glut.h>
 #else
+// Request prototypes of the OpenGL 1.5+ entry points (buffer objects, shaders).
+#ifndef GL_GLEXT_PROTOTYPES
+#define GL_GLEXT_PROTOTYPES
+#endif
 #include <GL/glut.h>
 #endif
 
+#include <map>
+#include <vector>
+
 // Dependencies on core types.
 //#include <types/vector_types.hpp>
 #include <types/Color.hpp>
@@ -63,11 +70,23 @@ typedef enum {CIRCLE, PLUS, CROSS, SQUARE, NO_MARK, NO_LINE, ONE_CIRCLE} mark;
 class DrawingUtils {
 public:
 
+	/*!
+	 * Constructor. Resets the cached viewport.
+	 */
+	DrawingUtils();
+
 	/*!
 	 * Virtual destructor. Empty.
 	 */
 	virtual ~DrawingUtils () {}
 
+	/*!
+	 * Updates the cached viewport size. Invalidates all layout-dependent data (e.g. grid vertices).
+	 * @param width_ Viewport width.
+	 * @param height_ Viewport height.
+	 */
+	void setViewport(GLint width_, GLint height_);
+
 	/*!
 	 * Draws image in current window.
 	 * @param img
@@ -107,7 +126,7 @@ public:
 	void draw_frame(float x1, float y1, float x2, float y2, float r, float g, float b, float a);
 
 	/*!
-	 * Draws grid (i.e. horizontal and vertical lines).
+	 * Draws grid (i.e. horizontal and vertical lines). Vertices are cached and recomputed only when the viewport changes.
 	 * @param r
 	 * @param g
 	 * @param b
@@ -336,6 +355,31 @@ public:
 	 */
 	//v_3f get_3d_position(int x, int y, float plane);
 
+protected:
+	/// Cached width of the viewport - set on reshape, so there is no need for querying GLUT during drawing.
+	GLint viewport_width;
+
+	/// Cached height of the viewport.
+	GLint viewport_height;
+
+	/// Counter incremented every time the viewport changes - used for lazy recomputation of layout-dependent data.
+	unsigned long viewport_revision;
+
+private:
+	/*!
+	 * Structure storing vertices of a grid computed for a given viewport revision.
+	 */
+	struct GridVertices {
+		/// Viewport revision the vertices were computed for.
+		unsigned long revision;
+
+		/// Coordinates of the ends of lines.
+		std::vector<GLint> vertices;
+	};
+
+	/// Cache of grid vertices, indexed by number of (horizontal, vertical) cells.
+	std::map<std::pair<float, float>, GridVertices> grid_cache;
+
 };
 
 } /* namespace visualization */
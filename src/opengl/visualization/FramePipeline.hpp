@@ -0,0 +1,184 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file FramePipeline.hpp
+ * \brief Contains declaration (and definition) of a class template preparing frames in a background thread.
+ * \author tkornuta
+ * \date Oct 18, 2026
+ */
+
+#ifndef SRC_OPENGL_VISUALIZATION_FRAMEPIPELINE_HPP_
+#define SRC_OPENGL_VISUALIZATION_FRAMEPIPELINE_HPP_
+
+#include <logger/Log.hpp>
+
+#include <boost/function.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/thread.hpp>
+
+#include <exception>
+#include <memory>
+
+namespace mic {
+namespace opengl {
+namespace visualization {
+
+/*!
+ * \brief Two-stage pipeline: frames submitted by the GL thread are prepared (normalized, coloured, packed) in a background thread, while the GL thread uploads and draws the previously prepared frame.
+ *
+ * Stages are connected by single-slot mailboxes - a new frame replaces the frame waiting in the slot, so stale frames are dropped instead of being queued.
+ * In effect, throughput is limited by the slowest stage instead of the sum of the stages, and the latency never exceeds two frames.
+ * \author tkornuta
+ * \tparam FrameT Type of the frame - contains both the snapshot of data and the prepared buffers.
+ */
+template <typename FrameT>
+class FramePipeline {
+public:
+	/*!
+	 * Type of function preparing the frame.
+	 */
+	typedef boost::function<void (FrameT&)> PrepareFunction;
+
+	/*!
+	 * Constructor. Starts the preparation thread.
+	 * @param prepare_ Function preparing the frame - called in the preparation thread.
+	 */
+	FramePipeline(PrepareFunction prepare_) :
+		prepare(prepare_),
+		terminate(false),
+		dropped_frames(0)
+	{
+		thread = boost::thread(&FramePipeline<FrameT>::prepareLoop, this);
+	}
+
+	/*!
+	 * Destructor. Stops the preparation thread.
+	 */
+	virtual ~FramePipeline() {
+		{
+			boost::mutex::scoped_lock lock(mutex);
+			terminate = true;
+		}
+		submitted.notify_one();
+		thread.join();
+	}
+
+	/*!
+	 * Submits frame for preparation. Frame still waiting for preparation is dropped.
+	 * @param frame_ Frame containing snapshot of data.
+	 */
+	void submit(const std::shared_ptr<FrameT> & frame_) {
+		{
+			boost::mutex::scoped_lock lock(mutex);
+			if (pending != nullptr)
+				dropped_frames++;
+			pending = frame_;
+		}
+		submitted.notify_one();
+	}
+
+	/*!
+	 * Takes the newest prepared frame.
+	 * @return Prepared frame or nullptr if no frame was prepared since the last call.
+	 */
+	std::shared_ptr<FrameT> takePrepared() {
+		boost::mutex::scoped_lock lock(mutex);
+		std::shared_ptr<FrameT> frame;
+		frame.swap(prepared);
+		return frame;
+	}
+
+	/*!
+	 * Returns number of frames dropped (replaced by newer ones or failed to be prepared) so far.
+	 */
+	size_t getDroppedFrames() {
+		boost::mutex::scoped_lock lock(mutex);
+		return dropped_frames;
+	}
+
+private:
+	/*!
+	 * Main loop of the preparation thread. Frame whose preparation failed (threw) is logged and dropped, the loop continues with the next one.
+	 */
+	void prepareLoop() {
+		while (true) {
+			std::shared_ptr<FrameT> frame;
+			{
+				boost::mutex::scoped_lock lock(mutex);
+				while ((pending == nullptr) && !terminate)
+					submitted.wait(lock);
+				if (terminate)
+					return;
+				frame.swap(pending);
+			}
+
+			try {
+				prepare(*frame);
+			} catch (const std::exception & e) {
+				LOG(LERROR) << "Preparation of frame failed: " << e.what();
+				frame.reset();
+			} catch (...) {
+				LOG(LERROR) << "Preparation of frame failed: unknown exception";
+				frame.reset();
+			}//: catch
+
+			if (frame == nullptr) {
+				boost::mutex::scoped_lock lock(mutex);
+				dropped_frames++;
+				continue;
+			}//: if
+
+			{
+				boost::mutex::scoped_lock lock(mutex);
+				// Prepared frame that was not drawn yet is stale.
+				if (prepared != nullptr)
+					dropped_frames++;
+				prepared = frame;
+			}
+		}//: while
+	}
+
+	/// Function preparing the frame.
+	PrepareFunction prepare;
+
+	/// Mutex protecting the mailboxes.
+	boost::mutex mutex;
+
+	/// Condition variable signalling submission of a frame.
+	boost::condition_variable submitted;
+
+	/// Frame waiting for preparation.
+	std::shared_ptr<FrameT> pending;
+
+	/// Prepared frame waiting for upload.
+	std::shared_ptr<FrameT> prepared;
+
+	/// Flag informing the preparation thread that it should terminate.
+	bool terminate;
+
+	/// Number of dropped frames.
+	size_t dropped_frames;
+
+	/// Preparation thread.
+	boost::thread thread;
+};
+
+} /* namespace visualization */
+} /* namespace opengl */
+} /* namespace mic */
+
+#endif /* SRC_OPENGL_VISUALIZATION_FRAMEPIPELINE_HPP_ */
@@ -0,0 +1,142 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file Grayscale.hpp
+ * \brief Contains enumerators and helpers used in windows displaying grayscale (single channel) data.
+ * \author tkornuta
+ * \date Oct 18, 2026
+ */
+
+#ifndef SRC_OPENGL_VISUALIZATION_GRAYSCALE_HPP_
+#define SRC_OPENGL_VISUALIZATION_GRAYSCALE_HPP_
+
+#include <string>
+
+namespace mic {
+namespace opengl {
+namespace visualization {
+
+/*!
+ * \brief Class containing enumerators used in grayscale windows.
+ * \author tkornuta
+ */
+class Grayscale {
+public:
+
+	/*!
+	 * Normalization of the grayscale (single channel) images.
+	 */
+	enum Normalization {
+		Norm_None, //< Display original image(s), without any normalization (negative values simply won't be visible).
+		Norm_Positive, //< Display image(s) normalized to <0,1>.
+		Norm_HotCold, //< Display image(s) in a hot-cold normalization <-1,1> i.e. red are positive and blue are negative values.
+		Norm_TensorFLow //< Display image(s) in a inverted hot-cold normalization <-1,1> i.e. red are negative and blue are positive values.
+	};
+
+	/*!
+	 * Method returning description of a given type of normalization.
+	 */
+	std::string norm2str(Normalization norm_)
+	{
+		switch(norm_) {
+		case(Norm_None):
+			return "Display original image(s), without any normalization";
+		case(Norm_Positive):
+			return "Display image(s) normalized to <0,1>";
+		case(Norm_HotCold):
+			return "Display image(s) in a hot-cold normalization <-1,1> i.e. red are positive and blue are negative";
+		case(Norm_TensorFLow):
+			return "Display inverted hot-cold normalization <-1,1> i.e. red are negative and blue are positive";
+		}
+		return "UNDEFINED";
+	}
+
+	/*!
+	 * Computes colour of a single value according to a given normalization mode.
+	 * @param norm_ Normalization mode.
+	 * @param val_ Value.
+	 * @param min_ Minimal value of the image.
+	 * @param max_ Maximal value of the image.
+	 * @param diff_ Difference between max and min (must be non-zero).
+	 * @param red_ Returned red component.
+	 * @param green_ Returned green component.
+	 * @param blue_ Returned blue component.
+	 * @param alpha_ Returned alpha component.
+	 */
+	template <typename eT>
+	static void colorize(Normalization norm_, eT val_, eT min_, eT max_, eT diff_, eT & red_, eT & green_, eT & blue_, eT & alpha_)
+	{
+		// Color depending on the visualization.
+		switch(norm_) {
+		case Normalization::Norm_Positive:
+			red_ = green_ = blue_ = (val_ - min_)/diff_;
+			alpha_ = 1.0f;
+			break;
+		case Normalization::Norm_HotCold:
+			red_ = (val_ > 0.0) ? val_/max_ : 0.0f;
+			green_ = 0.0f;
+			blue_ = (val_ < 0.0) ? val_/min_ : 0.0f;
+			alpha_ = 1.0f;
+			break;
+		case Normalization::Norm_TensorFLow:
+			blue_ = (val_ > 0.0) ? val_/max_ : 0.0f;
+			green_ = 0.0f;
+			red_ = (val_ < 0.0) ? val_/min_ : 0.0f;
+			alpha_ = 1.0f;
+			break;
+		// None is default.
+		case Normalization::Norm_None:
+		default:
+			red_ = green_ = blue_ = alpha_ = val_/diff_;
+			break;
+		}//: switch
+	}
+
+	/*!
+	 * Types of grids to be displayed.
+	 */
+	enum Grid {
+		Grid_None, //< No grid
+		Grid_Sample, //< Display only grid dividing sample cells.
+		Grid_Batch, //< Display grid dividing samples.
+		Grid_Both //< Display both sample and batch grids.
+	};
+
+	/*!
+	 * Method returning description of a given grid display mode.
+	 */
+	std::string grid2str(Grid grid_)
+	{
+		switch(grid_) {
+		case(Grid_None):
+			return "Display no grid";
+		case(Grid_Sample):
+			return "Display only grid dividing sample cells";
+		case(Grid_Batch):
+			return "Display grid dividing samples";
+		case(Grid_Both):
+			return "Display both sample and batch grids";
+		}
+		return "UNDEFINED";
+	}
+
+};
+
+} /* namespace visualization */
+} /* namespace opengl */
+} /* namespace mic */
+
+#endif /* SRC_OPENGL_VISUALIZATION_GRAYSCALE_HPP_ */
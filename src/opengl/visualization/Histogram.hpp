@@ -0,0 +1,250 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file Histogram.hpp
+ * \brief Contains declaration of a class computing histograms of large arrays of values in parallel.
+ * \author tkornuta
+ * \date Oct 18, 2026
+ */
+
+#ifndef SRC_OPENGL_VISUALIZATION_HISTOGRAM_HPP_
+#define SRC_OPENGL_VISUALIZATION_HISTOGRAM_HPP_
+
+#include <opengl/visualization/WorkerPool.hpp>
+
+#include <Eigen/Core>
+#include <boost/bind.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace mic {
+namespace opengl {
+namespace visualization {
+
+/*!
+ * \brief Class computing histograms of large arrays of values in parallel (does not depend on OpenGL).
+ *
+ * Every chunk of data is quantized in a vectorized (Eigen) pass and counted into its own partial histogram, partial histograms are merged at the end.
+ * Bin edges are either fixed or adapted to the range of the finite values (values outside of the fixed range are counted in the border bins).
+ * Non-finite values (NaN, inf) are not binned - they are only counted.
+ * \author tkornuta
+ * \tparam eT Precision (float/double) (DEFAULT=float).
+ */
+template <typename eT = float>
+class Histogram {
+public:
+	/*!
+	 * Constructor.
+	 * @param bins_ Number of bins.
+	 */
+	Histogram(size_t bins_ = 64) :
+		bins(std::max<size_t>(1, bins_)),
+		edge_min(0), edge_max(0),
+		non_finite_count(0),
+		data_ptr(nullptr), data_size(0), chunks(0)
+	{
+		counts.assign(bins, 0);
+	}
+
+	/*!
+	 * Computes histogram with bin edges adapted to the range of finite values.
+	 * @param data_ Pointer to the values.
+	 * @param size_ Number of values.
+	 */
+	void compute(const eT* data_, size_t size_) {
+		if (!split(data_, size_))
+			return;
+		VGL_WORKER_POOL->parallelFor(0, chunks, 1, boost::bind(&Histogram<eT>::findMinMaxOfChunks, this, _1, _2));
+		edge_min = *std::min_element(partial_min.begin(), partial_min.end());
+		edge_max = *std::max_element(partial_max.begin(), partial_max.end());
+		// No finite values.
+		if (edge_min > edge_max)
+			edge_min = edge_max = 0;
+		count();
+	}
+
+	/*!
+	 * Computes histogram with fixed bin edges.
+	 * @param data_ Pointer to the values.
+	 * @param size_ Number of values.
+	 * @param min_ Lower edge of the first bin.
+	 * @param max_ Upper edge of the last bin.
+	 */
+	void compute(const eT* data_, size_t size_, eT min_, eT max_) {
+		edge_min = min_;
+		edge_max = max_;
+		if (!split(data_, size_))
+			return;
+		count();
+	}
+
+	/*!
+	 * Returns number of bins.
+	 */
+	size_t getBins() const { return bins; }
+
+	/*!
+	 * Returns counts of bins.
+	 */
+	const std::vector<size_t> & getCounts() const { return counts; }
+
+	/*!
+	 * Returns number of non-finite values.
+	 */
+	size_t getNonFiniteCount() const { return non_finite_count; }
+
+	/*!
+	 * Returns lower edge of the first bin.
+	 */
+	eT getMin() const { return edge_min; }
+
+	/*!
+	 * Returns upper edge of the last bin.
+	 */
+	eT getMax() const { return edge_max; }
+
+private:
+	/*!
+	 * Resets counts and splits data into chunks with their own partial histograms.
+	 * @return False if there is no data.
+	 */
+	bool split(const eT* data_, size_t size_) {
+		std::fill(counts.begin(), counts.end(), 0);
+		non_finite_count = 0;
+		data_ptr = data_;
+		data_size = (data_ == nullptr) ? 0 : size_;
+		if (data_size == 0)
+			return false;
+
+		chunks = std::max<size_t>(1, std::min(data_size / WorkerPool::min_elements_per_task, 4 * (VGL_WORKER_POOL->getNumberOfWorkers() + 1)));
+		partial_min.resize(chunks);
+		partial_max.resize(chunks);
+		// Every partial histogram has an additional slot counting non-finite values.
+		partials.resize(chunks * (bins + 1));
+		return true;
+	}
+
+	/*!
+	 * Counts values and merges partial histograms.
+	 */
+	void count() {
+		VGL_WORKER_POOL->parallelFor(0, chunks, 1, boost::bind(&Histogram<eT>::binChunks, this, _1, _2));
+		for (size_t c = 0; c < chunks; c++) {
+			for (size_t b = 0; b < bins; b++)
+				counts[b] += partials[c * (bins + 1) + b];
+			non_finite_count += partials[c * (bins + 1) + bins];
+		}//: for
+	}
+
+	/*!
+	 * Finds min/max of finite values of a range of chunks of data (ranges can be processed in parallel). Chunks without finite values get min greater than max.
+	 * @param first_ Index of the first chunk.
+	 * @param last_ Index of the chunk after the last one.
+	 */
+	void findMinMaxOfChunks(size_t first_, size_t last_) {
+		for (size_t c = first_; c < last_; c++) {
+			size_t begin = c * data_size / chunks;
+			size_t end = (c + 1) * data_size / chunks;
+			Eigen::Map<const Eigen::Array<eT, Eigen::Dynamic, 1> > values(data_ptr + begin, end - begin);
+			Eigen::Array<bool, Eigen::Dynamic, 1> finite = values.template cast<float>().isFinite();
+			partial_min[c] = finite.select(values, std::numeric_limits<eT>::max()).minCoeff();
+			partial_max[c] = finite.select(values, std::numeric_limits<eT>::lowest()).maxCoeff();
+		}//: for
+	}
+
+	/*!
+	 * Counts values of a range of chunks of data into their partial histograms (ranges can be processed in parallel).
+	 * Non-finite values are counted in the additional slot following the bins.
+	 * @param first_ Index of the first chunk.
+	 * @param last_ Index of the chunk after the last one.
+	 */
+	void binChunks(size_t first_, size_t last_) {
+		float min = (float)edge_min;
+		float max = (float)edge_max;
+		// Non-finite edges (e.g. fixed by the user) - all values are counted in the first bin.
+		if (!std::isfinite(min) || !std::isfinite(max))
+			min = max = 0.0f;
+		float scale = (max > min) ? (float)bins / (max - min) : 0.0f;
+		// Positions and indices of bins of a block of values - local, as chunks are processed in parallel.
+		Eigen::ArrayXf positions(block_size);
+		Eigen::ArrayXi indices(block_size);
+		for (size_t c = first_; c < last_; c++) {
+			size_t* partial = &partials[c * (bins + 1)];
+			std::fill(partial, partial + bins + 1, 0);
+			size_t end = (c + 1) * data_size / chunks;
+			for (size_t begin = c * data_size / chunks; begin < end; begin += block_size) {
+				size_t n = std::min(block_size, end - begin);
+				// Quantize - vectorized by Eigen. Positions are sanitized before the cast: NaN (possible when an overflowing difference meets zero scale) goes to the first bin, non-finite values to the additional slot.
+				Eigen::Map<const Eigen::Array<eT, Eigen::Dynamic, 1> > values(data_ptr + begin, n);
+				positions.head(n) = (values.template cast<float>() - min) * scale;
+				positions.head(n) = positions.head(n).isNaN().select(0.0f, positions.head(n)).max(0.0f).min((float)(bins - 1));
+				indices.head(n) = values.template cast<float>().isFinite().select(positions.head(n), (float)bins).template cast<int>();
+				// Count.
+				for (size_t i = 0; i < n; i++)
+					partial[indices[i]]++;
+			}//: for
+		}//: for
+	}
+
+	/// Number of bins.
+	size_t bins;
+
+	/// Lower edge of the first bin.
+	eT edge_min;
+
+	/// Upper edge of the last bin.
+	eT edge_max;
+
+	/// Counts of bins.
+	std::vector<size_t> counts;
+
+	/// Number of non-finite values.
+	size_t non_finite_count;
+
+	/// Pointer to binned data (valid during binning).
+	const eT* data_ptr;
+
+	/// Number of binned values.
+	size_t data_size;
+
+	/// Number of chunks the data is split into.
+	size_t chunks;
+
+	/// Min values of chunks.
+	std::vector<eT> partial_min;
+
+	/// Max values of chunks.
+	std::vector<eT> partial_max;
+
+	/// Partial histograms of chunks.
+	std::vector<size_t> partials;
+
+	/// Number of values quantized in a single vectorized pass.
+	static const size_t block_size = 4096;
+};
+
+// Static members.
+template <typename eT>
+const size_t Histogram<eT>::block_size;
+
+} /* namespace visualization */
+} /* namespace opengl */
+} /* namespace mic */
+
+#endif /* SRC_OPENGL_VISUALIZATION_HISTOGRAM_HPP_ */
@@ -0,0 +1,261 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file MatrixPyramid.cpp
+ * \brief Contains definition of a class storing a level-of-detail pyramid of a matrix.
+ * \author tkornuta
+ * \date Oct 18, 2026
+ */
+
+#include <opengl/visualization/MatrixPyramid.hpp>
+#include <opengl/visualization/WorkerPool.hpp>
+
+#include <boost/bind.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+
+namespace mic {
+namespace opengl {
+namespace visualization {
+
+namespace {
+
+/// Mean of the block.
+struct MeanReduction {
+	static float reduce(float a_, float b_, float c_, float d_) { return 0.25f * (a_ + b_ + c_ + d_); }
+};
+
+/// Value of the largest magnitude in the block.
+struct MaxAbsReduction {
+	static float pick(float a_, float b_) { return (std::fabs(b_) > std::fabs(a_)) ? b_ : a_; }
+	static float reduce(float a_, float b_, float c_, float d_) { return pick(pick(a_, b_), pick(c_, d_)); }
+};
+
+/// Min value of the block.
+struct MinReduction {
+	static float reduce(float a_, float b_, float c_, float d_) { return std::min(std::min(a_, b_), std::min(c_, d_)); }
+};
+
+/// Max value of the block.
+struct MaxReduction {
+	static float reduce(float a_, float b_, float c_, float d_) { return std::max(std::max(a_, b_), std::max(c_, d_)); }
+};
+
+/*!
+ * Reduces 2x2 blocks of a range of columns of the source (column-major) level.
+ * Elements on the odd edges are duplicated, which gives exact results for all reductions (e.g. mean of a 1x2 block).
+ */
+template <typename Reduction>
+void reduceBlocks(const float* src_, size_t src_rows_, size_t src_cols_, float* dst_, size_t dst_rows_, size_t begin_, size_t end_) {
+	for (size_t x = begin_; x < end_; x++) {
+		// Destination column is reduced from (at most) two source columns.
+		const float* col0 = src_ + 2 * x * src_rows_;
+		const float* col1 = (2 * x + 1 < src_cols_) ? col0 + src_rows_ : col0;
+		float* dst = dst_ + x * dst_rows_;
+		for (size_t y = 0; y < dst_rows_; y++) {
+			size_t y0 = 2 * y;
+			size_t y1 = std::min(y0 + 1, src_rows_ - 1);
+			dst[y] = Reduction::reduce(col0[y0], col0[y1], col1[y0], col1[y1]);
+		}//: for
+	}//: for
+}
+
+} /* namespace */
+
+MatrixPyramid::MatrixPyramid() :
+	matrix_ptr(nullptr),
+	reduction(Reduction_Mean),
+	next_level(0), next_col(0),
+	preview_level(0),
+	preview_min(0.0f), preview_max(0.0f),
+	data_min(0.0f), data_max(0.0f)
+{
+}
+
+void MatrixPyramid::build(mic::types::MatrixXfPtr matrix_ptr_, PyramidReduction reduction_) {
+	reset(matrix_ptr_, reduction_, 0);
+	refine(std::numeric_limits<double>::infinity());
+}
+
+void MatrixPyramid::reset(mic::types::MatrixXfPtr matrix_ptr_, PyramidReduction reduction_, size_t preview_size_) {
+	matrix_ptr = matrix_ptr_;
+	reduction = reduction_;
+	level_rows.clear();
+	level_cols.clear();
+	next_level = next_col = 0;
+	preview_level = 0;
+	if ((matrix_ptr == nullptr) || (matrix_ptr->size() == 0))
+		return;
+
+	// Compute sizes of levels - halve until a single element remains.
+	size_t rows = matrix_ptr->rows();
+	size_t cols = matrix_ptr->cols();
+	level_rows.push_back(rows);
+	level_cols.push_back(cols);
+	while ((rows > 1) || (cols > 1)) {
+		rows = (rows + 1) / 2;
+		cols = (cols + 1) / 2;
+		level_rows.push_back(rows);
+		level_cols.push_back(cols);
+	}//: while
+	if (levels.size() < level_rows.size())
+		levels.resize(level_rows.size());
+	// Only reserve memory - levels grow as they are built, so the matrix is not swept by initialization of huge levels.
+	for (size_t level = 1; level < level_rows.size(); level++) {
+		levels[level].clear();
+		levels[level].reserve(level_rows[level] * level_cols[level]);
+	}//: for
+
+	// Level 0 is always complete.
+	next_level = 1;
+	data_min = std::numeric_limits<float>::max();
+	data_max = -std::numeric_limits<float>::max();
+	if (level_rows.size() == 1)
+		data_min = data_max = (*matrix_ptr)(0, 0);
+
+	if (preview_size_ > 0) {
+		// Find the finest level not exceeding the size of the preview.
+		while ((preview_level < level_rows.size()) && ((level_rows[preview_level] > preview_size_) || (level_cols[preview_level] > preview_size_)))
+			preview_level++;
+		if (preview_level > 0) {
+			for (size_t level = preview_level; level < level_rows.size(); level++)
+				levels[level].resize(level_rows[level] * level_cols[level]);
+			sampleLevel(preview_level);
+			// Coarser levels are reduced from the preview.
+			for (size_t level = preview_level + 1; level < level_rows.size(); level++)
+				reduceColumns(level, 0, level_cols[level]);
+		}//: if
+		// Estimate min/max values.
+		const float* preview_ptr = getData(preview_level);
+		size_t preview_elements = level_rows[preview_level] * level_cols[preview_level];
+		preview_min = *std::min_element(preview_ptr, preview_ptr + preview_elements);
+		preview_max = *std::max_element(preview_ptr, preview_ptr + preview_elements);
+	}//: if
+}
+
+bool MatrixPyramid::refine(double budget_) {
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	while (!isComplete()) {
+		// Reduce a chunk of columns of the level in parallel.
+		size_t rows = level_rows[next_level];
+		size_t end = std::min(next_col + std::max<size_t>(1, refinement_step / rows), level_cols[next_level]);
+		if (levels[next_level].size() < end * rows)
+			levels[next_level].resize(end * rows);
+		VGL_WORKER_POOL->parallelFor(next_col, end, std::max<size_t>(1, WorkerPool::min_elements_per_task / rows),
+				boost::bind(&MatrixPyramid::reduceColumns, this, next_level, _1, _2));
+
+		// The first level reads every element of the matrix - accumulate min/max of the read columns.
+		if (next_level == 1) {
+			size_t first = 2 * next_col;
+			size_t count = std::min(2 * end, level_cols[0]) - first;
+			data_min = std::min(data_min, matrix_ptr->middleCols(first, count).minCoeff());
+			data_max = std::max(data_max, matrix_ptr->middleCols(first, count).maxCoeff());
+		}//: if
+
+		next_col = end;
+		if (next_col == level_cols[next_level]) {
+			next_level++;
+			next_col = 0;
+		}//: if
+
+		if (std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() >= budget_)
+			break;
+	}//: while
+	return isComplete();
+}
+
+bool MatrixPyramid::isAvailable(size_t level_, size_t col_end_) const {
+	// Built levels.
+	if ((level_ < next_level) || ((level_ == next_level) && (col_end_ <= next_col)))
+		return true;
+	// Preview (and the coarser levels).
+	return ((preview_level > 0) && (level_ >= preview_level));
+}
+
+const float* MatrixPyramid::getData(size_t level_) const {
+	if (level_ == 0)
+		return matrix_ptr->data();
+	return levels[level_].data();
+}
+
+size_t MatrixPyramid::selectLevel(size_t width_, size_t height_, size_t max_size_) const {
+	size_t level = 0;
+	// Coarsest level still covering every pixel of the window.
+	while ((level + 1 < level_rows.size()) && (level_rows[level + 1] >= height_) && (level_cols[level + 1] >= width_))
+		level++;
+	// The level must fit into a texture.
+	while ((level + 1 < level_rows.size()) && ((level_rows[level] > max_size_) || (level_cols[level] > max_size_)))
+		level++;
+	return level;
+}
+
+std::string MatrixPyramid::reduction2str(PyramidReduction reduction_) {
+	switch(reduction_) {
+	case Reduction_MaxAbs:
+		return "Reduce blocks of large matrices to the value of the largest magnitude";
+	case Reduction_Min:
+		return "Reduce blocks of large matrices to their min value";
+	case Reduction_Max:
+		return "Reduce blocks of large matrices to their max value";
+	case Reduction_Mean:
+	default:
+		return "Reduce blocks of large matrices to their mean value";
+	}//: switch
+}
+
+void MatrixPyramid::sampleLevel(size_t level_) {
+	size_t rows = level_rows[0];
+	size_t cols = level_cols[0];
+	const float* src = matrix_ptr->data();
+	float* dst = levels[level_].data();
+	size_t stride = (size_t)1 << level_;
+	for (size_t x = 0; x < level_cols[level_]; x++) {
+		const float* col = src + std::min(x * stride + stride / 2, cols - 1) * rows;
+		for (size_t y = 0; y < level_rows[level_]; y++)
+			dst[x * level_rows[level_] + y] = col[std::min(y * stride + stride / 2, rows - 1)];
+	}//: for
+}
+
+void MatrixPyramid::reduceColumns(size_t level_, size_t begin_, size_t end_) {
+	const float* src = getData(level_ - 1);
+	float* dst = levels[level_].data();
+	size_t src_rows = level_rows[level_ - 1];
+	size_t src_cols = level_cols[level_ - 1];
+	size_t dst_rows = level_rows[level_];
+	// Dispatch once per range, so there are no per-element branches.
+	switch(reduction) {
+	case Reduction_MaxAbs:
+		reduceBlocks<MaxAbsReduction>(src, src_rows, src_cols, dst, dst_rows, begin_, end_);
+		break;
+	case Reduction_Min:
+		reduceBlocks<MinReduction>(src, src_rows, src_cols, dst, dst_rows, begin_, end_);
+		break;
+	case Reduction_Max:
+		reduceBlocks<MaxReduction>(src, src_rows, src_cols, dst, dst_rows, begin_, end_);
+		break;
+	case Reduction_Mean:
+	default:
+		reduceBlocks<MeanReduction>(src, src_rows, src_cols, dst, dst_rows, begin_, end_);
+		break;
+	}//: switch
+}
+
+} /* namespace visualization */
+} /* namespace opengl */
+} /* namespace mic */
@@ -0,0 +1,210 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file MatrixPyramid.hpp
+ * \brief Declaration of MatrixPyramid class - a mipmap-like level-of-detail pyramid of a matrix.
+ * \author tkornuta
+ * \date Oct 18, 2026
+ */
+
+#ifndef SRC_OPENGL_VISUALIZATION_MATRIXPYRAMID_HPP_
+#define SRC_OPENGL_VISUALIZATION_MATRIXPYRAMID_HPP_
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// Dependencies on core types.
+#include <types/MatrixTypes.hpp>
+
+namespace mic {
+namespace opengl {
+namespace visualization {
+
+/*!
+ * \brief Enumerator defining reductions used for building of the pyramid.
+ * \author tkornuta
+ */
+enum PyramidReduction {
+	Reduction_Mean = 0, ///< Mean of the block (smooth, but isolated outliers fade out)
+	Reduction_MaxAbs, ///< Value of the largest magnitude in the block, with its sign (outliers remain visible)
+	Reduction_Min, ///< Min value of the block
+	Reduction_Max, ///< Max value of the block
+	Reduction_Count ///< Number of reductions (used for toggling)
+};
+
+/*!
+ * \brief Class storing a level-of-detail pyramid of a matrix.
+ *
+ * Level 0 is the matrix itself, every next level halves both dimensions (rounding up) by reducing 2x2 blocks of the previous one.
+ * Levels are stored column-major, just like the matrix, and are built in parallel on the worker pool.
+ *
+ * Pyramid can be built progressively: reset() only fills a small preview level by point sampling of the matrix (fast regardless of its size),
+ * then every call of refine() reduces further columns of levels (from the finest one) until a given time budget is exhausted.
+ * Storage of levels is reused between builds, so building the pyramid of matrices of the same size does not allocate memory.
+ * \author tkornuta
+ */
+class MatrixPyramid {
+public:
+	/*!
+	 * Constructor. Creates an empty pyramid.
+	 */
+	MatrixPyramid();
+
+	/*!
+	 * Builds all levels of the pyramid of a given matrix.
+	 * @param matrix_ptr_ Pointer to the matrix (level 0, shared - not copied).
+	 * @param reduction_ Reduction used for building of the levels.
+	 */
+	void build(mic::types::MatrixXfPtr matrix_ptr_, PyramidReduction reduction_);
+
+	/*!
+	 * Starts progressive building of the pyramid of a given matrix (aborts building of the previous one).
+	 * Fills the finest level not exceeding a given size (and the coarser ones) with values sampled from the matrix, so they can be displayed right away.
+	 * @param matrix_ptr_ Pointer to the matrix (level 0, shared - not copied).
+	 * @param reduction_ Reduction used for building of the levels.
+	 * @param preview_size_ Max number of rows and columns of the preview level (0 - no preview).
+	 */
+	void reset(mic::types::MatrixXfPtr matrix_ptr_, PyramidReduction reduction_, size_t preview_size_ = 256);
+
+	/*!
+	 * Continues progressive building of the pyramid.
+	 * @param budget_ Time budget (in milliseconds) - at least one step is performed, then building stops when the budget is exhausted.
+	 * @return True if the pyramid is complete.
+	 */
+	bool refine(double budget_);
+
+	/*!
+	 * Returns true if all levels are built.
+	 */
+	bool isComplete() const { return next_level >= level_rows.size(); }
+
+	/*!
+	 * Checks whether columns of a given level can be displayed (are already built or belong to the preview).
+	 * @param level_ Index of the level.
+	 * @param col_end_ Column after the last required one.
+	 */
+	bool isAvailable(size_t level_, size_t col_end_) const;
+
+	/*!
+	 * Returns min value of the matrix (estimated from the preview until the pyramid is complete).
+	 */
+	float getMin() const { return isComplete() ? data_min : preview_min; }
+
+	/*!
+	 * Returns max value of the matrix (estimated from the preview until the pyramid is complete).
+	 */
+	float getMax() const { return isComplete() ? data_max : preview_max; }
+
+	/*!
+	 * Returns number of levels (0 if the pyramid is empty).
+	 */
+	size_t getLevels() const { return level_rows.size(); }
+
+	/*!
+	 * Returns number of rows of a given level.
+	 */
+	size_t getRows(size_t level_) const { return level_rows[level_]; }
+
+	/*!
+	 * Returns number of columns of a given level.
+	 */
+	size_t getCols(size_t level_) const { return level_cols[level_]; }
+
+	/*!
+	 * Returns pointer to the (column-major) data of a given level.
+	 */
+	const float* getData(size_t level_) const;
+
+	/*!
+	 * Selects the coarsest level still having at least one element per pixel of the window, with both dimensions not exceeding a given size.
+	 * @param width_ Width of the window (corresponding to columns).
+	 * @param height_ Height of the window (corresponding to rows).
+	 * @param max_size_ Max number of rows and columns of the level (e.g. max size of a texture).
+	 * @return Index of the level.
+	 */
+	size_t selectLevel(size_t width_, size_t height_, size_t max_size_) const;
+
+	/*!
+	 * Returns reduction used for building of the pyramid.
+	 */
+	PyramidReduction getReduction() const { return reduction; }
+
+	/*!
+	 * Method returning description of a given reduction.
+	 */
+	static std::string reduction2str(PyramidReduction reduction_);
+
+private:
+	/*!
+	 * Reduces a range of columns of a given level from the previous one (ranges can be processed in parallel).
+	 * @param level_ Index of the level (greater than 0).
+	 * @param begin_ Index of the first column.
+	 * @param end_ Index of the column after the last one.
+	 */
+	void reduceColumns(size_t level_, size_t begin_, size_t end_);
+
+	/*!
+	 * Fills a given level with values sampled from the matrix (centres of the reduced blocks).
+	 * @param level_ Index of the level (greater than 0).
+	 */
+	void sampleLevel(size_t level_);
+
+	/// Pointer to the matrix (level 0).
+	mic::types::MatrixXfPtr matrix_ptr;
+
+	/// Reduction used for building of the pyramid.
+	PyramidReduction reduction;
+
+	/// Data of levels (data of level 0 is not stored - it is the matrix itself).
+	std::vector<std::vector<float> > levels;
+
+	/// Number of rows of levels.
+	std::vector<size_t> level_rows;
+
+	/// Number of columns of levels.
+	std::vector<size_t> level_cols;
+
+	/// Level being built.
+	size_t next_level;
+
+	/// Next column of the level being built.
+	size_t next_col;
+
+	/// Index of the preview level (0 - no preview).
+	size_t preview_level;
+
+	/// Min value of the preview.
+	float preview_min;
+
+	/// Max value of the preview.
+	float preview_max;
+
+	/// Min value of the matrix (accumulated while building the first level).
+	float data_min;
+
+	/// Max value of the matrix (accumulated while building the first level).
+	float data_max;
+
+	/// Number of elements of a level reduced in a single step of progressive building.
+	static const size_t refinement_step = 262144;
+};
+
+} /* namespace visualization */
+} /* namespace opengl */
+} /* namespace mic */
+
+#endif /* SRC_OPENGL_VISUALIZATION_MATRIXPYRAMID_HPP_ */
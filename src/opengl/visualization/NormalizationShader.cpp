@@ -0,0 +1,103 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file NormalizationShader.cpp
+ * \brief Contains definitions of methods and sources of the NormalizationShader.
+ * \author tkornuta
+ * \date Oct 18, 2026
+ */
+
+#include <opengl/visualization/NormalizationShader.hpp>
+
+namespace mic {
+namespace opengl {
+namespace visualization {
+
+/// Vertex shader - passes the texture coordinates, uses fixed pipeline transformations.
+static const char* normalization_vertex_source =
+	"#version 120\n"
+	"void main() {\n"
+	"	gl_TexCoord[0] = gl_MultiTexCoord0;\n"
+	"	gl_Position = ftransform();\n"
+	"}\n";
+
+/// Fragment shader - colours the raw values (GLSL 1.20, so it runs on software renderers as well).
+static const char* normalization_fragment_source =
+	"#version 120\n"
+	"uniform sampler2D data;\n"
+	"uniform int composition;\n"
+	"uniform int normalization;\n"
+	"uniform float min_value;\n"
+	"uniform float max_value;\n"
+	"uniform float range;\n"
+	"uniform vec3 channel;\n"
+	"uniform vec3 tint;\n"
+	"void main() {\n"
+	"	vec2 st = gl_TexCoord[0].st;\n"
+	"	vec4 texel = texture2D(data, st);\n"
+	"	float v = texel.r;\n"
+	"	if (composition == 1) {\n"
+	"		// Single channel of RGB texture.\n"
+	"		gl_FragColor = vec4(dot(texel.rgb, channel) * tint, 1.0);\n"
+	"	} else if (normalization == 1) {\n"
+	"		// Norm_Positive.\n"
+	"		gl_FragColor = vec4(vec3((v - min_value) / range), 1.0);\n"
+	"	} else if (normalization == 2) {\n"
+	"		// Norm_HotCold.\n"
+	"		gl_FragColor = vec4((v > 0.0) ? v / max_value : 0.0, 0.0, (v < 0.0) ? v / min_value : 0.0, 1.0);\n"
+	"	} else if (normalization == 3) {\n"
+	"		// Norm_TensorFLow.\n"
+	"		gl_FragColor = vec4((v < 0.0) ? v / min_value : 0.0, 0.0, (v > 0.0) ? v / max_value : 0.0, 1.0);\n"
+	"	} else {\n"
+	"		// Norm_None.\n"
+	"		gl_FragColor = vec4(v / range);\n"
+	"	}\n"
+	"}\n";
+
+NormalizationShader::NormalizationShader() :
+		ShaderProgram(normalization_vertex_source, normalization_fragment_source)
+{
+}
+
+void NormalizationShader::useComposition(Composition composition_) {
+	use();
+	setUniform("data", (GLint)0);
+	setUniform("composition", (GLint)composition_);
+}
+
+void NormalizationShader::useGrayscale(Grayscale::Normalization norm_, float min_, float max_) {
+	useComposition(Comp_Grayscale);
+	// Special case: all values are equal - the same handling as in the fixed pipeline.
+	float range = max_ - min_;
+	if (range == 0.0f) {
+		min_ = max_ = 0.0f;
+		range = 1.0f;
+	}//: if
+	setUniform("normalization", (GLint)norm_);
+	setUniform("min_value", min_);
+	setUniform("max_value", max_);
+	setUniform("range", range);
+}
+
+void NormalizationShader::useChannel(size_t channel_, float r_, float g_, float b_) {
+	useComposition(Comp_Channel);
+	setUniform("channel", (channel_ == 0) ? 1.0f : 0.0f, (channel_ == 1) ? 1.0f : 0.0f, (channel_ == 2) ? 1.0f : 0.0f);
+	setUniform("tint", r_, g_, b_);
+}
+
+} /* namespace visualization */
+} /* namespace opengl */
+} /* namespace mic */
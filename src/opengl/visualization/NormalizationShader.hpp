@@ -0,0 +1,89 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file NormalizationShader.hpp
+ * \brief Contains declaration of a shader colouring raw (float) textures according to the normalization modes.
+ * \author tkornuta
+ * \date Oct 18, 2026
+ */
+
+#ifndef SRC_OPENGL_VISUALIZATION_NORMALIZATIONSHADER_HPP_
+#define SRC_OPENGL_VISUALIZATION_NORMALIZATIONSHADER_HPP_
+
+#include <opengl/visualization/ShaderProgram.hpp>
+#include <opengl/visualization/Grayscale.hpp>
+
+namespace mic {
+namespace opengl {
+namespace visualization {
+
+/*!
+ * \brief Shader program colouring single channel float textures on the GPU.
+ *
+ * Raw data is uploaded once per publication, whereas normalization (and min/max values) are passed as uniforms - so changing the mode does not require re-uploading.
+ * Supports two compositions: grayscale normalization (Grayscale::Normalization) of single channel textures and a single, tinted channel of RGB textures.
+ * \author tkornuta
+ */
+class NormalizationShader : public ShaderProgram {
+public:
+	/*!
+	 * Constructor. Sets the sources of the shaders.
+	 */
+	NormalizationShader();
+
+	/*!
+	 * Destructor. Empty.
+	 */
+	virtual ~NormalizationShader() { }
+
+	/*!
+	 * Activates the program in the grayscale mode.
+	 * @param norm_ Normalization mode.
+	 * @param min_ Minimal value of the data.
+	 * @param max_ Maximal value of the data.
+	 */
+	void useGrayscale(Grayscale::Normalization norm_, float min_, float max_);
+
+	/*!
+	 * Activates the program in the channel mode: a single channel is selected from an RGB texture and multiplied by a given colour.
+	 * @param channel_ Index of the channel (0 - red, 1 - green, 2 - blue).
+	 * @param r_ Red component of the tint.
+	 * @param g_ Green component of the tint.
+	 * @param b_ Blue component of the tint.
+	 */
+	void useChannel(size_t channel_, float r_, float g_, float b_);
+
+	/*!
+	 * Composition modes - must be consistent with the fragment shader.
+	 */
+	enum Composition {
+		Comp_Grayscale = 0, //< Single channel, coloured according to normalization.
+		Comp_Channel = 1 //< Single channel of RGB texture multiplied by the tint colour.
+	};
+
+private:
+	/*!
+	 * Activates the program and sets the composition.
+	 * @param composition_ Composition mode.
+	 */
+	void useComposition(Composition composition_);
+};
+
+} /* namespace visualization */
+} /* namespace opengl */
+} /* namespace mic */
+
+#endif /* SRC_OPENGL_VISUALIZATION_NORMALIZATIONSHADER_HPP_ */
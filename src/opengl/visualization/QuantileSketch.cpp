@@ -0,0 +1,165 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file QuantileSketch.cpp
+ * \brief Contains definition of a mergeable sketch estimating quantiles of a stream of values.
+ * \author tkornuta
+ * \date Oct 18, 2026
+ */
+
+#include <opengl/visualization/QuantileSketch.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace mic {
+namespace opengl {
+namespace visualization {
+
+namespace {
+
+const double pi = 3.14159265358979323846;
+
+/*!
+ * Scale function of the t-digest - maps quantile to the index of centroid (centroids must not span more than one unit).
+ * @param q_ Quantile.
+ * @param compression_ Compression.
+ */
+double quantileToScale(double q_, double compression_) {
+	return compression_ / (2.0 * pi) * std::asin(2.0 * q_ - 1.0);
+}
+
+/*!
+ * Inverse of the scale function.
+ * @param k_ Index of centroid.
+ * @param compression_ Compression.
+ */
+double scaleToQuantile(double k_, double compression_) {
+	if (k_ >= compression_ / 4.0)
+		return 1.0;
+	return (std::sin(k_ * 2.0 * pi / compression_) + 1.0) / 2.0;
+}
+
+} //: namespace
+
+QuantileSketch::QuantileSketch(double compression_) :
+		compression(std::max(10.0, compression_)), total_weight(0.0), min_value(0.0), max_value(0.0)
+{
+}
+
+void QuantileSketch::add(double value_, double weight_) {
+	// Non-finite values would break the ordering and means of centroids.
+	if (!std::isfinite(value_))
+		return;
+	if (total_weight == 0.0) {
+		min_value = max_value = value_;
+	} else {
+		min_value = std::min(min_value, value_);
+		max_value = std::max(max_value, value_);
+	}//: else
+	total_weight += weight_;
+
+	Centroid centroid;
+	centroid.mean = value_;
+	centroid.weight = weight_;
+	buffer.push_back(centroid);
+	// Merge in batches - sorting of the buffer is amortized over many values.
+	if (buffer.size() >= 5 * (size_t)compression)
+		compress();
+}
+
+void QuantileSketch::merge(const QuantileSketch & other_) {
+	if (other_.total_weight == 0.0)
+		return;
+	if (total_weight == 0.0) {
+		min_value = other_.min_value;
+		max_value = other_.max_value;
+	} else {
+		min_value = std::min(min_value, other_.min_value);
+		max_value = std::max(max_value, other_.max_value);
+	}//: else
+	total_weight += other_.total_weight;
+	buffer.insert(buffer.end(), other_.centroids.begin(), other_.centroids.end());
+	buffer.insert(buffer.end(), other_.buffer.begin(), other_.buffer.end());
+	compress();
+}
+
+void QuantileSketch::compress() {
+	if (buffer.empty())
+		return;
+	buffer.insert(buffer.end(), centroids.begin(), centroids.end());
+	std::sort(buffer.begin(), buffer.end());
+	centroids.clear();
+
+	// Greedily merge neighbouring centroids, as long as they fit into the limit of the scale function.
+	Centroid current = buffer[0];
+	double weight_so_far = 0.0;
+	double q_limit = scaleToQuantile(quantileToScale(0.0, compression) + 1.0, compression);
+	for (size_t i = 1; i < buffer.size(); i++) {
+		double proposed = current.weight + buffer[i].weight;
+		if (weight_so_far + proposed <= q_limit * total_weight) {
+			current.mean += (buffer[i].mean - current.mean) * buffer[i].weight / proposed;
+			current.weight = proposed;
+		} else {
+			centroids.push_back(current);
+			weight_so_far += current.weight;
+			q_limit = scaleToQuantile(quantileToScale(weight_so_far / total_weight, compression) + 1.0, compression);
+			current = buffer[i];
+		}//: else
+	}//: for
+	centroids.push_back(current);
+	buffer.clear();
+}
+
+double QuantileSketch::quantile(double q_) {
+	compress();
+	if (centroids.empty())
+		return 0.0;
+	if (centroids.size() == 1)
+		return centroids[0].mean;
+
+	// Centroids are assumed to be centred at their cumulative weights - interpolate between the neighbouring ones.
+	double target = std::min(std::max(q_, 0.0), 1.0) * total_weight;
+	double first_center = centroids[0].weight / 2.0;
+	if (target <= first_center)
+		return min_value + (centroids[0].mean - min_value) * ((first_center > 0.0) ? target / first_center : 0.0);
+
+	double center = first_center;
+	for (size_t i = 1; i < centroids.size(); i++) {
+		double next_center = center + (centroids[i - 1].weight + centroids[i].weight) / 2.0;
+		if (target <= next_center) {
+			double t = (target - center) / (next_center - center);
+			return centroids[i - 1].mean + t * (centroids[i].mean - centroids[i - 1].mean);
+		}//: if
+		center = next_center;
+	}//: for
+
+	// Tail after the last centroid.
+	double last_weight = total_weight - center;
+	double t = (last_weight > 0.0) ? (target - center) / last_weight : 1.0;
+	return centroids.back().mean + std::min(t, 1.0) * (max_value - centroids.back().mean);
+}
+
+void QuantileSketch::clear() {
+	centroids.clear();
+	buffer.clear();
+	total_weight = 0.0;
+	min_value = max_value = 0.0;
+}
+
+} /* namespace visualization */
+} /* namespace opengl */
+} /* namespace mic */
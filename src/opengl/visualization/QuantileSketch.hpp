@@ -0,0 +1,132 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file QuantileSketch.hpp
+ * \brief Contains declaration of a mergeable sketch estimating quantiles of a stream of values.
+ * \author tkornuta
+ * \date Oct 18, 2026
+ */
+
+#ifndef SRC_OPENGL_VISUALIZATION_QUANTILESKETCH_HPP_
+#define SRC_OPENGL_VISUALIZATION_QUANTILESKETCH_HPP_
+
+#include <cstddef>
+#include <vector>
+
+namespace mic {
+namespace opengl {
+namespace visualization {
+
+/*!
+ * \brief Mergeable sketch estimating quantiles of a stream of values (a merging t-digest).
+ *
+ * Values are summarized by centroids (means with weights). Centroids near the tails represent few values, so extreme quantiles are accurate, while the ones near the median are large.
+ * Memory is bounded by the compression parameter (roughly that many centroids), regardless of the number of added values.
+ * Incoming values are buffered and merged into the centroids in batches. Sketches can be merged (e.g. when neighbouring buckets of a chart are combined).
+ * \author tkornuta
+ */
+class QuantileSketch {
+public:
+	/*!
+	 * Constructor. Creates an empty sketch.
+	 * @param compression_ Compression - higher values give more accurate estimates at the cost of memory (DEFAULT=100).
+	 */
+	QuantileSketch(double compression_ = 100.0);
+
+	/*!
+	 * Adds value to the sketch (non-finite values are ignored).
+	 * @param value_ Value.
+	 * @param weight_ Weight of the value (DEFAULT=1).
+	 */
+	void add(double value_, double weight_ = 1.0);
+
+	/*!
+	 * Adds values summarized by another sketch.
+	 * @param other_ Merged sketch.
+	 */
+	void merge(const QuantileSketch & other_);
+
+	/*!
+	 * Returns estimate of a given quantile (merges buffered values first).
+	 * @param q_ Quantile (from 0 to 1).
+	 * @return Estimated value (0 if the sketch is empty).
+	 */
+	double quantile(double q_);
+
+	/*!
+	 * Removes all values from the sketch.
+	 */
+	void clear();
+
+	/*!
+	 * Returns total weight (number) of added values.
+	 */
+	double getCount() const { return total_weight; }
+
+	/*!
+	 * Returns min of added values.
+	 */
+	double getMin() const { return min_value; }
+
+	/*!
+	 * Returns max of added values.
+	 */
+	double getMax() const { return max_value; }
+
+private:
+	/*!
+	 * \brief Centroid summarizing a group of neighbouring values.
+	 */
+	struct Centroid {
+		/// Mean of values.
+		double mean;
+
+		/// Weight (number) of values.
+		double weight;
+
+		/// Orders centroids by means.
+		bool operator<(const Centroid & other_) const { return mean < other_.mean; }
+	};
+
+	/*!
+	 * Merges buffered values with centroids, so centroids satisfy the size limits of the scale function.
+	 */
+	void compress();
+
+	/// Compression.
+	double compression;
+
+	/// Centroids (sorted by means).
+	std::vector<Centroid> centroids;
+
+	/// Values added since the last compression.
+	std::vector<Centroid> buffer;
+
+	/// Total weight of added values.
+	double total_weight;
+
+	/// Min of added values.
+	double min_value;
+
+	/// Max of added values.
+	double max_value;
+};
+
+} /* namespace visualization */
+} /* namespace opengl */
+} /* namespace mic */
+
+#endif /* SRC_OPENGL_VISUALIZATION_QUANTILESKETCH_HPP_ */
@@ -0,0 +1,150 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file ShaderProgram.cpp
+ * \brief Contains definitions of methods of the ShaderProgram class.
+ * \author tkornuta
+ * \date Oct 18, 2026
+ */
+
+#include <opengl/visualization/ShaderProgram.hpp>
+
+#include <logger/Log.hpp>
+
+#include <cstdio>
+#include <vector>
+
+namespace mic {
+namespace opengl {
+namespace visualization {
+
+ShaderProgram::ShaderProgram(std::string vertex_source_, std::string fragment_source_) :
+		vertex_source(vertex_source_), fragment_source(fragment_source_),
+		program_id(0), build_attempted(false)
+{
+}
+
+ShaderProgram::~ShaderProgram() {
+	if (program_id != 0)
+		glDeleteProgram(program_id);
+}
+
+bool ShaderProgram::isSupported() {
+	const char* version = (const char*)glGetString(GL_VERSION);
+	if (version == NULL)
+		return false;
+	int major = 0, minor = 0;
+	if (sscanf(version, "%d.%d", &major, &minor) != 2)
+		return false;
+	return (major >= 2);
+}
+
+bool ShaderProgram::build() {
+	// Build only once - if failed, do not try again.
+	if (build_attempted)
+		return isValid();
+	build_attempted = true;
+
+	if (!isSupported()) {
+		LOG(LWARNING) << "GLSL programs are not supported by the OpenGL context, falling back to the fixed pipeline";
+		return false;
+	}//: if
+
+	GLuint vertex = compile(GL_VERTEX_SHADER, vertex_source);
+	GLuint fragment = compile(GL_FRAGMENT_SHADER, fragment_source);
+	if ((vertex == 0) || (fragment == 0)) {
+		glDeleteShader(vertex);
+		glDeleteShader(fragment);
+		return false;
+	}//: if
+
+	// Link the program.
+	GLuint program = glCreateProgram();
+	glAttachShader(program, vertex);
+	glAttachShader(program, fragment);
+	glLinkProgram(program);
+	// Shaders are not needed after linking.
+	glDeleteShader(vertex);
+	glDeleteShader(fragment);
+
+	GLint status;
+	glGetProgramiv(program, GL_LINK_STATUS, &status);
+	if (status != GL_TRUE) {
+		GLint length = 0;
+		glGetProgramiv(program, GL_INFO_LOG_LENGTH, &length);
+		std::vector<GLchar> log(length + 1, 0);
+		glGetProgramInfoLog(program, length, NULL, log.data());
+		LOG(LERROR) << "Linking of the shader program failed: " << log.data();
+		glDeleteProgram(program);
+		return false;
+	}//: if
+
+	program_id = program;
+	return true;
+}
+
+GLuint ShaderProgram::compile(GLenum type_, const std::string & source_) {
+	GLuint shader = glCreateShader(type_);
+	const GLchar* source = source_.c_str();
+	glShaderSource(shader, 1, &source, NULL);
+	glCompileShader(shader);
+
+	GLint status;
+	glGetShaderiv(shader, GL_COMPILE_STATUS, &status);
+	if (status != GL_TRUE) {
+		GLint length = 0;
+		glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &length);
+		std::vector<GLchar> log(length + 1, 0);
+		glGetShaderInfoLog(shader, length, NULL, log.data());
+		LOG(LERROR) << "Compilation of the shader failed: " << log.data();
+		glDeleteShader(shader);
+		return 0;
+	}//: if
+	return shader;
+}
+
+void ShaderProgram::use() {
+	glUseProgram(program_id);
+}
+
+void ShaderProgram::release() {
+	glUseProgram(0);
+}
+
+GLint ShaderProgram::uniformLocation(const std::string & name_) {
+	std::map<std::string, GLint>::iterator it = uniform_locations.find(name_);
+	if (it != uniform_locations.end())
+		return it->second;
+	GLint location = glGetUniformLocation(program_id, name_.c_str());
+	uniform_locations[name_] = location;
+	return location;
+}
+
+void ShaderProgram::setUniform(const std::string & name_, GLint value_) {
+	glUniform1i(uniformLocation(name_), value_);
+}
+
+void ShaderProgram::setUniform(const std::string & name_, GLfloat value_) {
+	glUniform1f(uniformLocation(name_), value_);
+}
+
+void ShaderProgram::setUniform(const std::string & name_, GLfloat x_, GLfloat y_, GLfloat z_) {
+	glUniform3f(uniformLocation(name_), x_, y_, z_);
+}
+
+} /* namespace visualization */
+} /* namespace opengl */
+} /* namespace mic */
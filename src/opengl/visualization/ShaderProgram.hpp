@@ -0,0 +1,140 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file ShaderProgram.hpp
+ * \brief Contains declaration of a class wrapping a GLSL shader program.
+ * \author tkornuta
+ * \date Oct 18, 2026
+ */
+
+#ifndef SRC_OPENGL_VISUALIZATION_SHADERPROGRAM_HPP_
+#define SRC_OPENGL_VISUALIZATION_SHADERPROGRAM_HPP_
+
+#include <opengl/visualization/DrawingUtils.hpp>
+
+#include <string>
+#include <map>
+
+namespace mic {
+namespace opengl {
+namespace visualization {
+
+/*!
+ * \brief Class wrapping a GLSL program consisting of a vertex and a fragment shader.
+ *
+ * Program is built lazily (in the context current during the first call of build()), as every GLUT window has its own OpenGL context.
+ * \author tkornuta
+ */
+class ShaderProgram {
+public:
+	/*!
+	 * Constructor. Stores the sources, does not compile them.
+	 * @param vertex_source_ Source of the vertex shader.
+	 * @param fragment_source_ Source of the fragment shader.
+	 */
+	ShaderProgram(std::string vertex_source_, std::string fragment_source_);
+
+	/*!
+	 * Destructor. Releases the program.
+	 */
+	virtual ~ShaderProgram();
+
+	/*!
+	 * Checks whether the current context supports GLSL programs (OpenGL 2.0 or newer).
+	 */
+	static bool isSupported();
+
+	/*!
+	 * Compiles and links the program (only during the first call).
+	 * @return True if program is ready to use, false if the compilation/linking failed or GLSL is not supported.
+	 */
+	bool build();
+
+	/*!
+	 * Returns true if the program was successfully built.
+	 */
+	bool isValid() const { return program_id != 0; }
+
+	/*!
+	 * Activates the program.
+	 */
+	void use();
+
+	/*!
+	 * Deactivates the program, i.e. switches back to the fixed pipeline.
+	 */
+	void release();
+
+	/*!
+	 * Sets integer (or sampler) uniform of the active program.
+	 * @param name_ Name of the uniform.
+	 * @param value_ Value.
+	 */
+	void setUniform(const std::string & name_, GLint value_);
+
+	/*!
+	 * Sets float uniform of the active program.
+	 * @param name_ Name of the uniform.
+	 * @param value_ Value.
+	 */
+	void setUniform(const std::string & name_, GLfloat value_);
+
+	/*!
+	 * Sets vec3 uniform of the active program.
+	 * @param name_ Name of the uniform.
+	 * @param x_ First component.
+	 * @param y_ Second component.
+	 * @param z_ Third component.
+	 */
+	void setUniform(const std::string & name_, GLfloat x_, GLfloat y_, GLfloat z_);
+
+protected:
+	/*!
+	 * Returns location of a given uniform (cached).
+	 * @param name_ Name of the uniform.
+	 */
+	GLint uniformLocation(const std::string & name_);
+
+private:
+	/*!
+	 * Compiles a single shader.
+	 * @param type_ Type of the shader (GL_VERTEX_SHADER/GL_FRAGMENT_SHADER).
+	 * @param source_ Source of the shader.
+	 * @return Shader id or 0 in case of error.
+	 */
+	GLuint compile(GLenum type_, const std::string & source_);
+
+	/// Source of the vertex shader.
+	std::string vertex_source;
+
+	/// Source of the fragment shader.
+	std::string fragment_source;
+
+	/// Id of the linked program (0 if not built).
+	GLuint program_id;
+
+	/// Flag indicating whether building was already attempted.
+	bool build_attempted;
+
+	/// Cache of uniform locations.
+	std::map<std::string, GLint> uniform_locations;
+};
+
+} /* namespace visualization */
+} /* namespace opengl */
+} /* namespace mic */
+
+#endif /* SRC_OPENGL_VISUALIZATION_SHADERPROGRAM_HPP_ */
@@ -0,0 +1,146 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file Texture2D.cpp
+ * \brief Contains definitions of methods of the Texture2D class.
+ * \author tkornuta
+ * \date Oct 18, 2026
+ */
+
+#include <opengl/visualization/Texture2D.hpp>
+
+namespace mic {
+namespace opengl {
+namespace visualization {
+
+Texture2D::Texture2D() :
+		texture_id(0), internal_format(0), width(0), height(0), filter(GL_NEAREST)
+{
+}
+
+Texture2D::~Texture2D() {
+	release();
+}
+
+void Texture2D::release() {
+	if (texture_id != 0)
+		glDeleteTextures(1, &texture_id);
+	texture_id = 0;
+	internal_format = 0;
+	width = height = 0;
+}
+
+void Texture2D::uploadLuminance(size_t width_, size_t height_, const float* data_) {
+	upload(GL_LUMINANCE32F_ARB, GL_LUMINANCE, GL_FLOAT, width_, height_, data_);
+}
+
+void Texture2D::uploadLuminance(size_t width_, size_t height_, const uint8_t* data_) {
+	upload(GL_LUMINANCE8, GL_LUMINANCE, GL_UNSIGNED_BYTE, width_, height_, data_);
+}
+
+void Texture2D::uploadRGB(size_t width_, size_t height_, const uint8_t* data_) {
+	upload(GL_RGB8, GL_RGB, GL_UNSIGNED_BYTE, width_, height_, data_);
+}
+
+void Texture2D::uploadRGBA(size_t width_, size_t height_, const uint32_t* data_) {
+	upload(GL_RGBA8, GL_RGBA, GL_UNSIGNED_BYTE, width_, height_, data_);
+}
+
+void Texture2D::uploadLuminanceRow(size_t row_, const float* data_) {
+	uploadRow(GL_LUMINANCE32F_ARB, GL_LUMINANCE, GL_FLOAT, row_, data_);
+}
+
+void Texture2D::uploadRGBARow(size_t row_, const uint32_t* data_) {
+	uploadRow(GL_RGBA8, GL_RGBA, GL_UNSIGNED_BYTE, row_, data_);
+}
+
+void Texture2D::upload(GLint internal_format_, GLenum format_, GLenum type_, size_t width_, size_t height_, const GLvoid* data_) {
+	if ((width_ == 0) || (height_ == 0))
+		return;
+
+	if (texture_id == 0) {
+		glGenTextures(1, &texture_id);
+		glBindTexture(GL_TEXTURE_2D, texture_id);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, filter);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, filter);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+	} else
+		glBindTexture(GL_TEXTURE_2D, texture_id);
+
+	// Rows are tightly packed.
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+	if ((internal_format_ != internal_format) || (width_ != width) || (height_ != height)) {
+		// Size or format has changed - reallocate.
+		glTexImage2D(GL_TEXTURE_2D, 0, internal_format_, (GLsizei)width_, (GLsizei)height_, 0, format_, type_, data_);
+		internal_format = internal_format_;
+		width = width_;
+		height = height_;
+	} else
+		glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, (GLsizei)width_, (GLsizei)height_, format_, type_, data_);
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+	glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+void Texture2D::uploadRow(GLint internal_format_, GLenum format_, GLenum type_, size_t row_, const GLvoid* data_) {
+	if ((texture_id == 0) || (internal_format_ != internal_format) || (row_ >= height))
+		return;
+
+	glBindTexture(GL_TEXTURE_2D, texture_id);
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+	glTexSubImage2D(GL_TEXTURE_2D, 0, 0, (GLint)row_, (GLsizei)width, 1, format_, type_, data_);
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+	glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+void Texture2D::setFilter(GLint filter_) {
+	filter = filter_;
+	if (texture_id == 0)
+		return;
+	glBindTexture(GL_TEXTURE_2D, texture_id);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, filter);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, filter);
+	glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+void Texture2D::bind() {
+	glBindTexture(GL_TEXTURE_2D, texture_id);
+}
+
+void Texture2D::unbind() {
+	glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+void Texture2D::draw(float x, float y, float h, float w, float s0, float t0, float s1, float t1, bool transposed_) {
+	glBegin(GL_QUADS);
+	if (!transposed_) {
+		glTexCoord2f(s0, t0); glVertex2f(x, y);
+		glTexCoord2f(s1, t0); glVertex2f(x + w, y);
+		glTexCoord2f(s1, t1); glVertex2f(x + w, y + h);
+		glTexCoord2f(s0, t1); glVertex2f(x, y + h);
+	} else {
+		glTexCoord2f(s0, t0); glVertex2f(x, y);
+		glTexCoord2f(s0, t1); glVertex2f(x + w, y);
+		glTexCoord2f(s1, t1); glVertex2f(x + w, y + h);
+		glTexCoord2f(s1, t0); glVertex2f(x, y + h);
+	}//: else
+	glEnd();
+}
+
+} /* namespace visualization */
+} /* namespace opengl */
+} /* namespace mic */
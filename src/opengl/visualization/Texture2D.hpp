@@ -0,0 +1,209 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file Texture2D.hpp
+ * \brief Contains declaration of a class wrapping a 2D OpenGL texture.
+ * \author tkornuta
+ * \date Oct 18, 2026
+ */
+
+#ifndef SRC_OPENGL_VISUALIZATION_TEXTURE2D_HPP_
+#define SRC_OPENGL_VISUALIZATION_TEXTURE2D_HPP_
+
+#include <opengl/visualization/DrawingUtils.hpp>
+
+#include <cstddef>
+#include <stdint.h>
+#include <vector>
+
+namespace mic {
+namespace opengl {
+namespace visualization {
+
+/*!
+ * \brief Class wrapping a 2D texture, responsible for uploading data and drawing textured rectangles.
+ *
+ * Texture is allocated lazily and reallocated only when the size or format of the uploaded data changes, otherwise the content is replaced with glTexSubImage2D.
+ * All methods must be called from the thread owning the OpenGL context.
+ * \author tkornuta
+ */
+class Texture2D {
+public:
+	/*!
+	 * Constructor. Does not allocate the texture.
+	 */
+	Texture2D();
+
+	/*!
+	 * Destructor. Releases the texture.
+	 */
+	virtual ~Texture2D();
+
+	/*!
+	 * Uploads single channel float data (raw values, not clamped).
+	 * @param width_ Width of the texture (number of values in a row).
+	 * @param height_ Height of the texture (number of rows).
+	 * @param data_ Pointer to the data.
+	 */
+	void uploadLuminance(size_t width_, size_t height_, const float* data_);
+
+	/*!
+	 * Uploads single channel float data, converting it from a different precision.
+	 * @param width_ Width of the texture (number of values in a row).
+	 * @param height_ Height of the texture (number of rows).
+	 * @param data_ Pointer to the data.
+	 */
+	template <typename eT>
+	void uploadLuminance(size_t width_, size_t height_, const eT* data_) {
+		conversion_buffer.assign(data_, data_ + width_ * height_);
+		uploadLuminance(width_, height_, conversion_buffer.data());
+	}
+
+	/*!
+	 * Uploads single channel 8-bit data.
+	 * @param width_ Width of the texture (number of values in a row).
+	 * @param height_ Height of the texture (number of rows).
+	 * @param data_ Pointer to the data.
+	 */
+	void uploadLuminance(size_t width_, size_t height_, const uint8_t* data_);
+
+	/*!
+	 * Uploads interleaved RGB8 colours.
+	 * @param width_ Width of the texture (number of pixels in a row).
+	 * @param height_ Height of the texture (number of rows).
+	 * @param data_ Pointer to the data (3 bytes per pixel).
+	 */
+	void uploadRGB(size_t width_, size_t height_, const uint8_t* data_);
+
+	/*!
+	 * Uploads packed RGBA8 colours (bytes in R, G, B, A order in memory).
+	 * @param width_ Width of the texture (number of values in a row).
+	 * @param height_ Height of the texture (number of rows).
+	 * @param data_ Pointer to the data.
+	 */
+	void uploadRGBA(size_t width_, size_t height_, const uint32_t* data_);
+
+	/*!
+	 * Replaces a single row of a single channel float texture (the texture must be already allocated with uploadLuminance).
+	 * @param row_ Index of the row.
+	 * @param data_ Pointer to the data (width values).
+	 */
+	void uploadLuminanceRow(size_t row_, const float* data_);
+
+	/*!
+	 * Replaces a single row of a RGBA8 texture (the texture must be already allocated with uploadRGBA).
+	 * @param row_ Index of the row.
+	 * @param data_ Pointer to the data (width values).
+	 */
+	void uploadRGBARow(size_t row_, const uint32_t* data_);
+
+	/*!
+	 * Sets filtering used when the texture is magnified or minified.
+	 * @param filter_ GL_NEAREST (DEFAULT - every texel is displayed as a sharp cell) or GL_LINEAR (texels are interpolated, e.g. for resampling of low resolution data).
+	 */
+	void setFilter(GLint filter_);
+
+	/*!
+	 * Binds the texture to the active texture unit.
+	 */
+	void bind();
+
+	/*!
+	 * Unbinds the texture from the active texture unit.
+	 */
+	void unbind();
+
+	/*!
+	 * Draws rectangle covered by a given region of the texture. The texture must be bound (or enabled in the fixed pipeline).
+	 * @param x Left coordinate of the rectangle.
+	 * @param y Top coordinate of the rectangle.
+	 * @param h Height of the rectangle.
+	 * @param w Width of the rectangle.
+	 * @param s0 Left texture coordinate.
+	 * @param t0 Top texture coordinate.
+	 * @param s1 Right texture coordinate.
+	 * @param t1 Bottom texture coordinate.
+	 * @param transposed_ If set, s coordinate is mapped to the vertical axis and t to the horizontal one (used for column-major matrices).
+	 */
+	void draw(float x, float y, float h, float w, float s0 = 0.0f, float t0 = 0.0f, float s1 = 1.0f, float t1 = 1.0f, bool transposed_ = false);
+
+	/*!
+	 * Releases the texture (it will be allocated again by the next upload).
+	 */
+	void release();
+
+	/*!
+	 * Returns true if the texture holds any data.
+	 */
+	bool isAllocated() const { return texture_id != 0; }
+
+	/*!
+	 * Returns width of the texture.
+	 */
+	size_t getWidth() const { return width; }
+
+	/*!
+	 * Returns height of the texture.
+	 */
+	size_t getHeight() const { return height; }
+
+protected:
+	/*!
+	 * Uploads data in a given format, (re)allocating the texture if required.
+	 * @param internal_format_ Internal format of the texture.
+	 * @param format_ Format of the data.
+	 * @param type_ Type of the data.
+	 * @param width_ Width of the texture.
+	 * @param height_ Height of the texture.
+	 * @param data_ Pointer to the data.
+	 */
+	void upload(GLint internal_format_, GLenum format_, GLenum type_, size_t width_, size_t height_, const GLvoid* data_);
+
+	/*!
+	 * Replaces a single row of the allocated texture.
+	 * @param internal_format_ Internal format the texture must have been allocated with.
+	 * @param format_ Format of the data.
+	 * @param type_ Type of the data.
+	 * @param row_ Index of the row.
+	 * @param data_ Pointer to the data.
+	 */
+	void uploadRow(GLint internal_format_, GLenum format_, GLenum type_, size_t row_, const GLvoid* data_);
+
+private:
+	/// Id of the texture (0 if not allocated).
+	GLuint texture_id;
+
+	/// Internal format of the allocated texture.
+	GLint internal_format;
+
+	/// Width of the allocated texture.
+	size_t width;
+
+	/// Height of the allocated texture.
+	size_t height;
+
+	/// Filtering of the texture.
+	GLint filter;
+
+	/// Buffer used for conversion of data to single precision.
+	std::vector<float> conversion_buffer;
+};
+
+} /* namespace visualization */
+} /* namespace opengl */
+} /* namespace mic */
+
+#endif /* SRC_OPENGL_VISUALIZATION_TEXTURE2D_HPP_ */
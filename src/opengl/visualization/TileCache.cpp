@@ -0,0 +1,113 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file TileCache.cpp
+ * \brief Contains definition of a LRU cache of texture tiles.
+ * \author tkornuta
+ * \date Oct 18, 2026
+ */
+
+#include <opengl/visualization/TileCache.hpp>
+
+namespace mic {
+namespace opengl {
+namespace visualization {
+
+// Static members.
+const size_t TileCache::max_free_textures;
+
+TileCache::TileCache(size_t budget_) :
+	budget(budget_),
+	used_bytes(0),
+	frame(0)
+{
+}
+
+Texture2D* TileCache::find(size_t level_, size_t tile_x_, size_t tile_y_) {
+	std::map<uint64_t, std::list<Tile>::iterator>::iterator it = index.find(makeKey(level_, tile_x_, tile_y_));
+	if (it == index.end())
+		return nullptr;
+	// Move the tile to the front.
+	tiles.splice(tiles.begin(), tiles, it->second);
+	it->second->last_frame = frame;
+	return it->second->texture.get();
+}
+
+Texture2D* TileCache::insert(size_t level_, size_t tile_x_, size_t tile_y_, size_t bytes_) {
+	uint64_t key = makeKey(level_, tile_x_, tile_y_);
+	std::map<uint64_t, std::list<Tile>::iterator>::iterator it = index.find(key);
+	if (it != index.end()) {
+		// Tile is already cached - its texture will be simply overwritten.
+		tiles.splice(tiles.begin(), tiles, it->second);
+		it->second->last_frame = frame;
+		used_bytes = used_bytes - it->second->bytes + bytes_;
+		it->second->bytes = bytes_;
+		return it->second->texture.get();
+	}//: if
+
+	if (!evict(bytes_))
+		return nullptr;
+
+	Tile tile;
+	tile.key = key;
+	tile.bytes = bytes_;
+	tile.last_frame = frame;
+	// Reuse texture of an evicted tile if possible.
+	if (!free_textures.empty()) {
+		tile.texture = free_textures.back();
+		free_textures.pop_back();
+	} else
+		tile.texture = std::make_shared<Texture2D>();
+	tiles.push_front(tile);
+	index[key] = tiles.begin();
+	used_bytes += bytes_;
+	return tile.texture.get();
+}
+
+void TileCache::clear() {
+	// Keep a few textures for reuse - new data typically needs tiles of the same size. The rest is released, as free textures are not counted in the budget.
+	for (std::list<Tile>::iterator it = tiles.begin(); (it != tiles.end()) && (free_textures.size() < max_free_textures); it++)
+		free_textures.push_back(it->texture);
+	tiles.clear();
+	index.clear();
+	used_bytes = 0;
+}
+
+void TileCache::setBudget(size_t budget_) {
+	budget = budget_;
+	free_textures.clear();
+	evict(0);
+}
+
+bool TileCache::evict(size_t bytes_) {
+	while ((used_bytes + bytes_ > budget) && (!tiles.empty())) {
+		Tile & lru = tiles.back();
+		// Tiles used in the current frame are visible - stop.
+		if (lru.last_frame == frame)
+			return false;
+		used_bytes -= lru.bytes;
+		index.erase(lru.key);
+		// Keep a single texture for reuse - the evicted tile is replaced right away.
+		if (free_textures.empty())
+			free_textures.push_back(lru.texture);
+		tiles.pop_back();
+	}//: while
+	return (used_bytes + bytes_ <= budget);
+}
+
+} /* namespace visualization */
+} /* namespace opengl */
+} /* namespace mic */
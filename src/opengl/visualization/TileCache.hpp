@@ -0,0 +1,158 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file TileCache.hpp
+ * \brief Declaration of TileCache class - a LRU cache of texture tiles with a limited GPU memory budget.
+ * \author tkornuta
+ * \date Oct 18, 2026
+ */
+
+#ifndef SRC_OPENGL_VISUALIZATION_TILECACHE_HPP_
+#define SRC_OPENGL_VISUALIZATION_TILECACHE_HPP_
+
+#include <opengl/visualization/Texture2D.hpp>
+
+#include <cstddef>
+#include <list>
+#include <map>
+#include <memory>
+#include <stdint.h>
+#include <vector>
+
+namespace mic {
+namespace opengl {
+namespace visualization {
+
+/*!
+ * \brief Class storing textures of tiles of (levels of) a large matrix, limited by a GPU memory budget.
+ *
+ * Tiles are identified by level and coordinates. When the budget is exceeded, the least recently used tiles are evicted - but never the ones used in the current frame.
+ * Textures of evicted tiles are recycled (only a few are kept, as they are not counted in the budget), so streaming of tiles of the same size does not allocate new textures.
+ * All methods must be called from the thread owning the OpenGL context.
+ * \author tkornuta
+ */
+class TileCache {
+public:
+	/*!
+	 * Constructor.
+	 * @param budget_ GPU memory budget (in bytes).
+	 */
+	TileCache(size_t budget_ = 64 * 1024 * 1024);
+
+	/*!
+	 * Returns the texture of a given tile and marks it as used in the current frame.
+	 * @param level_ Level of the tile.
+	 * @param tile_x_ Horizontal index of the tile.
+	 * @param tile_y_ Vertical index of the tile.
+	 * @return Pointer to the texture or nullptr if the tile is not cached.
+	 */
+	Texture2D* find(size_t level_, size_t tile_x_, size_t tile_y_);
+
+	/*!
+	 * Adds a tile (marked as used in the current frame), evicting least recently used tiles if required.
+	 * @param level_ Level of the tile.
+	 * @param tile_x_ Horizontal index of the tile.
+	 * @param tile_y_ Vertical index of the tile.
+	 * @param bytes_ Size of the texture of the tile (in bytes).
+	 * @return Pointer to the texture the tile must be uploaded to or nullptr if it would not fit into the budget.
+	 */
+	Texture2D* insert(size_t level_, size_t tile_x_, size_t tile_y_, size_t bytes_);
+
+	/*!
+	 * Starts a new frame - tiles used in previous frames can be evicted.
+	 */
+	void nextFrame() { frame++; }
+
+	/*!
+	 * Removes all tiles (e.g. when the data changes).
+	 */
+	void clear();
+
+	/*!
+	 * Sets GPU memory budget, evicting tiles if required.
+	 * @param budget_ Budget (in bytes).
+	 */
+	void setBudget(size_t budget_);
+
+	/*!
+	 * Returns GPU memory budget (in bytes).
+	 */
+	size_t getBudget() const { return budget; }
+
+	/*!
+	 * Returns size of the cached tiles (in bytes).
+	 */
+	size_t getUsedBytes() const { return used_bytes; }
+
+private:
+	/*!
+	 * \brief Structure representing a cached tile.
+	 */
+	struct Tile {
+		/// Key of the tile.
+		uint64_t key;
+
+		/// Texture storing the tile.
+		std::shared_ptr<Texture2D> texture;
+
+		/// Size of the texture (in bytes).
+		size_t bytes;
+
+		/// Index of the frame the tile was used in for the last time.
+		size_t last_frame;
+	};
+
+	/*!
+	 * Combines level and coordinates of a tile into a key.
+	 */
+	static uint64_t makeKey(size_t level_, size_t tile_x_, size_t tile_y_) {
+		return ((uint64_t)level_ << 48) | ((uint64_t)tile_y_ << 24) | (uint64_t)tile_x_;
+	}
+
+	/*!
+	 * Evicts least recently used tiles (not used in the current frame) until a given number of bytes fits into the budget.
+	 * @param bytes_ Number of bytes.
+	 * @return True if the bytes fit into the budget.
+	 */
+	bool evict(size_t bytes_);
+
+	/// Tiles, ordered from the most to the least recently used.
+	std::list<Tile> tiles;
+
+	/// Index of tiles (by key).
+	std::map<uint64_t, std::list<Tile>::iterator> index;
+
+	/// Textures of evicted tiles, to be reused.
+	std::vector<std::shared_ptr<Texture2D> > free_textures;
+
+	/// Max number of textures kept for reuse.
+	static const size_t max_free_textures = 16;
+
+	/// GPU memory budget (in bytes).
+	size_t budget;
+
+	/// Size of the cached tiles (in bytes).
+	size_t used_bytes;
+
+	/// Index of the current frame.
+	size_t frame;
+};
+
+} /* namespace visualization */
+} /* namespace opengl */
+} /* namespace mic */
+
+#endif /* SRC_OPENGL_VISUALIZATION_TILECACHE_HPP_ */
@@ -0,0 +1,273 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file TrajectoryBuffer.cpp
+ * \brief Contains definition of a class storing trajectories of multiple agents in a single vertex buffer object.
+ * \author tkornuta
+ * \date Oct 18, 2026
+ */
+
+#include <opengl/visualization/TrajectoryBuffer.hpp>
+#include <opengl/visualization/Colormap.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+namespace mic {
+namespace opengl {
+namespace visualization {
+
+namespace {
+
+/*!
+ * Returns colour of a given agent - hues of consecutive agents are spread by the golden ratio, so they differ even for hundreds of agents.
+ * @param agent_ Index of the agent.
+ */
+uint32_t agentColor(size_t agent_) {
+	float hue = std::fmod(0.618034f * (float)agent_, 1.0f) * 6.0f;
+	float f = hue - std::floor(hue);
+	switch ((int)hue) {
+	case 0: return Colormap::pack(1.0f, f, 0.0f);
+	case 1: return Colormap::pack(1.0f - f, 1.0f, 0.0f);
+	case 2: return Colormap::pack(0.0f, 1.0f, f);
+	case 3: return Colormap::pack(0.0f, 1.0f - f, 1.0f);
+	case 4: return Colormap::pack(f, 0.0f, 1.0f);
+	default: return Colormap::pack(1.0f, 0.0f, 1.0f - f);
+	}//: switch
+}
+
+} //: namespace
+
+TrajectoryBuffer::TrajectoryBuffer(size_t initial_capacity_) :
+		used_vertices(0), buffer_id(0), buffer_capacity(0), buffer_outdated(true),
+		initial_capacity(std::max<size_t>(2, initial_capacity_)), max_length(0)
+{
+	ramp.setFilter(GL_LINEAR);
+}
+
+TrajectoryBuffer::~TrajectoryBuffer() {
+	if (buffer_id != 0)
+		glDeleteBuffers(1, &buffer_id);
+}
+
+void TrajectoryBuffer::append(size_t agent_, float x_, float y_) {
+	// Add agents.
+	while (agents.size() <= agent_) {
+		Agent agent;
+		agent.offset = vertices.size();
+		agent.capacity = initial_capacity;
+		agent.count = 0;
+		agent.uploaded = 0;
+		agent.rgba = agentColor(agents.size());
+		agents.push_back(agent);
+		vertices.resize(vertices.size() + initial_capacity);
+		used_vertices += initial_capacity;
+	}//: while
+
+	Agent & agent = agents[agent_];
+	if (agent.count == agent.capacity)
+		relocate(agent, 2 * agent.capacity);
+
+	Vertex & vertex = vertices[agent.offset + agent.count];
+	vertex.x = x_;
+	vertex.y = y_;
+	vertex.step = (GLfloat)agent.count;
+	vertex.rgba = agent.rgba;
+	agent.count++;
+	max_length = std::max(max_length, agent.count);
+}
+
+void TrajectoryBuffer::synchronize(size_t agent_, const std::vector<mic::types::Position2D> & path_) {
+	if (path_.size() < getLength(agent_))
+		resetAgent(agent_);
+	for (size_t i = getLength(agent_); i < path_.size(); i++)
+		append(agent_, (float)path_[i].x + 0.5f, (float)path_[i].y + 0.5f);
+}
+
+void TrajectoryBuffer::setPaths(const std::vector<std::shared_ptr<std::vector <mic::types::Position2D> > > & paths_) {
+	// Rebuild trajectories of agents whose paths were replaced.
+	for (size_t i = 0; i < agents.size(); i++)
+		if ((i >= paths_.size()) || (i >= paths.size()) || (paths_[i] != paths[i]))
+			resetAgent(i);
+	paths = paths_;
+}
+
+void TrajectoryBuffer::synchronizePaths() {
+	for (size_t i = 0; i < paths.size(); i++)
+		if (paths[i] != nullptr)
+			synchronize(i, *paths[i]);
+}
+
+void TrajectoryBuffer::resetAgent(size_t agent_) {
+	if (agent_ >= agents.size())
+		return;
+	agents[agent_].count = 0;
+	agents[agent_].uploaded = 0;
+	max_length = 0;
+	for (size_t i = 0; i < agents.size(); i++)
+		max_length = std::max(max_length, agents[i].count);
+}
+
+void TrajectoryBuffer::clear() {
+	agents.clear();
+	paths.clear();
+	vertices.clear();
+	used_vertices = 0;
+	max_length = 0;
+	buffer_outdated = true;
+}
+
+size_t TrajectoryBuffer::getLength(size_t agent_) const {
+	return (agent_ < agents.size()) ? agents[agent_].count : 0;
+}
+
+void TrajectoryBuffer::relocate(Agent & agent_, size_t capacity_) {
+	size_t offset = vertices.size();
+	vertices.resize(offset + capacity_);
+	std::copy(vertices.begin() + agent_.offset, vertices.begin() + agent_.offset + agent_.count, vertices.begin() + offset);
+	used_vertices += capacity_ - agent_.capacity;
+	agent_.offset = offset;
+	agent_.capacity = capacity_;
+	// The whole segment must be uploaded.
+	agent_.uploaded = 0;
+
+	// Drop abandoned segments when they take most of the buffer.
+	if (vertices.size() > 2 * used_vertices)
+		compact();
+}
+
+void TrajectoryBuffer::compact() {
+	std::vector<Vertex> compacted(used_vertices);
+	size_t offset = 0;
+	for (size_t i = 0; i < agents.size(); i++) {
+		std::copy(vertices.begin() + agents[i].offset, vertices.begin() + agents[i].offset + agents[i].count, compacted.begin() + offset);
+		agents[i].offset = offset;
+		offset += agents[i].capacity;
+	}//: for
+	vertices.swap(compacted);
+	buffer_outdated = true;
+}
+
+void TrajectoryBuffer::upload() {
+	if (buffer_id == 0)
+		glGenBuffers(1, &buffer_id);
+	glBindBuffer(GL_ARRAY_BUFFER, buffer_id);
+
+	// Reallocate when the content does not fit or takes only a small part of the buffer (e.g. after compaction or clearing).
+	if ((vertices.size() > buffer_capacity) || (buffer_capacity > 4 * vertices.size())) {
+		// Leave a margin proportional to the content, so the buffer does not have to be reallocated after every relocation.
+		buffer_capacity = vertices.size() + vertices.size() / 2;
+		glBufferData(GL_ARRAY_BUFFER, buffer_capacity * sizeof(Vertex), NULL, GL_DYNAMIC_DRAW);
+		buffer_outdated = true;
+	}//: if
+
+	if (buffer_outdated) {
+		// Upload the whole content (the allocated storage is kept).
+		glBufferSubData(GL_ARRAY_BUFFER, 0, vertices.size() * sizeof(Vertex), vertices.data());
+		for (size_t i = 0; i < agents.size(); i++)
+			agents[i].uploaded = agents[i].count;
+		buffer_outdated = false;
+	} else {
+		// Upload only the appended positions.
+		for (size_t i = 0; i < agents.size(); i++) {
+			Agent & agent = agents[i];
+			if (agent.uploaded < agent.count) {
+				glBufferSubData(GL_ARRAY_BUFFER, (agent.offset + agent.uploaded) * sizeof(Vertex),
+						(agent.count - agent.uploaded) * sizeof(Vertex), &vertices[agent.offset + agent.uploaded]);
+				agent.uploaded = agent.count;
+			}//: if
+		}//: for
+	}//: else
+
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void TrajectoryBuffer::draw(float scale_x_, float scale_y_, float line_width_) {
+	if (max_length == 0)
+		return;
+	upload();
+
+	// Brightness ramp - from a quarter to the full colour of the agent.
+	if (!ramp.isAllocated()) {
+		uint8_t levels[256];
+		for (size_t i = 0; i < 256; i++)
+			levels[i] = (uint8_t)(64 + (191 * i) / 255);
+		ramp.uploadLuminance(256, 1, levels);
+	}//: if
+
+	// Map steps of trajectories to the ramp.
+	glMatrixMode(GL_TEXTURE);
+	glPushMatrix();
+	glLoadIdentity();
+	glScalef(1.0f / (float)std::max<size_t>(1, max_length - 1), 1.0f, 1.0f);
+	glMatrixMode(GL_MODELVIEW);
+	glPushMatrix();
+	glScalef(scale_x_, scale_y_, 1.0f);
+
+	glEnable(GL_TEXTURE_2D);
+	glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
+	ramp.bind();
+
+	glBindBuffer(GL_ARRAY_BUFFER, buffer_id);
+	glEnableClientState(GL_VERTEX_ARRAY);
+	glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+	glEnableClientState(GL_COLOR_ARRAY);
+	glVertexPointer(2, GL_FLOAT, sizeof(Vertex), (const GLvoid*)offsetof(Vertex, x));
+	glTexCoordPointer(1, GL_FLOAT, sizeof(Vertex), (const GLvoid*)offsetof(Vertex, step));
+	glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(Vertex), (const GLvoid*)offsetof(Vertex, rgba));
+
+	// Trajectories.
+	firsts.clear();
+	counts.clear();
+	for (size_t i = 0; i < agents.size(); i++)
+		if (agents[i].count > 1) {
+			firsts.push_back((GLint)agents[i].offset);
+			counts.push_back((GLsizei)agents[i].count);
+		}//: if
+	glLineWidth(line_width_);
+	if (!firsts.empty())
+		glMultiDrawArrays(GL_LINE_STRIP, firsts.data(), counts.data(), (GLsizei)firsts.size());
+
+	// Current positions.
+	firsts.clear();
+	counts.clear();
+	for (size_t i = 0; i < agents.size(); i++)
+		if (agents[i].count > 0) {
+			firsts.push_back((GLint)(agents[i].offset + agents[i].count - 1));
+			counts.push_back(1);
+		}//: if
+	glPointSize(2.0f * line_width_ + 2.0f);
+	glMultiDrawArrays(GL_POINTS, firsts.data(), counts.data(), (GLsizei)firsts.size());
+	glPointSize(1.0f);
+
+	glDisableClientState(GL_COLOR_ARRAY);
+	glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+	glDisableClientState(GL_VERTEX_ARRAY);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	ramp.unbind();
+	glDisable(GL_TEXTURE_2D);
+
+	glPopMatrix();
+	glMatrixMode(GL_TEXTURE);
+	glPopMatrix();
+	glMatrixMode(GL_MODELVIEW);
+}
+
+} /* namespace visualization */
+} /* namespace opengl */
+} /* namespace mic */
@@ -0,0 +1,212 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file TrajectoryBuffer.hpp
+ * \brief Contains declaration of a class storing trajectories of multiple agents in a single vertex buffer object.
+ * \author tkornuta
+ * \date Oct 18, 2026
+ */
+
+#ifndef SRC_OPENGL_VISUALIZATION_TRAJECTORYBUFFER_HPP_
+#define SRC_OPENGL_VISUALIZATION_TRAJECTORYBUFFER_HPP_
+
+#include <opengl/visualization/Texture2D.hpp>
+
+// Dependencies on core types.
+#include <types/Position2D.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <stdint.h>
+#include <vector>
+
+namespace mic {
+namespace opengl {
+namespace visualization {
+
+/*!
+ * \brief Class storing trajectories of multiple agents (e.g. of a population-based experiment) in a single vertex buffer object.
+ *
+ * Every agent owns a segment of the buffer. Positions are appended to the segment and only the new ones are uploaded; a full segment is moved to a new, twice as large one at the end of the buffer.
+ * All trajectories are drawn with a single glMultiDrawArrays call. Every agent has its own colour, brightening along the trajectory (the ramp is relative to the longest trajectory).
+ * Positions can be appended from any thread (with data synchronization provided by the window), draw must be called from the thread owning the OpenGL context.
+ * \author tkornuta
+ */
+class TrajectoryBuffer {
+public:
+	/*!
+	 * Constructor. The buffer object is created lazily (during the first draw).
+	 * @param initial_capacity_ Initial number of positions reserved for every agent (DEFAULT=64).
+	 */
+	TrajectoryBuffer(size_t initial_capacity_ = 64);
+
+	/*!
+	 * Destructor. Releases the buffer object.
+	 */
+	virtual ~TrajectoryBuffer();
+
+	/*!
+	 * Appends position to the trajectory of a given agent (agents are added when required).
+	 * @param agent_ Index of the agent.
+	 * @param x_ X coordinate.
+	 * @param y_ Y coordinate.
+	 */
+	void append(size_t agent_, float x_, float y_);
+
+	/*!
+	 * Appends positions of the path that were not appended yet (the path is expected to grow). If the path is shorter than the stored trajectory, the trajectory is replaced.
+	 * Positions are shifted to the centres of cells.
+	 * @param agent_ Index of the agent.
+	 * @param path_ Path of the agent.
+	 */
+	void synchronize(size_t agent_, const std::vector<mic::types::Position2D> & path_);
+
+	/*!
+	 * Sets paths of agents (agent i follows the i-th path). Trajectories of agents whose paths were replaced (or removed) are rebuilt.
+	 * Paths are expected to grow - their new positions are appended by synchronizePaths().
+	 * @param paths_ Vector of paths (a path is a sequence of consecutive agent positions, can be null).
+	 */
+	void setPaths(const std::vector<std::shared_ptr<std::vector <mic::types::Position2D> > > & paths_);
+
+	/*!
+	 * Appends positions of the set paths that were not appended yet.
+	 */
+	void synchronizePaths();
+
+	/*!
+	 * Removes the trajectory of a given agent (the agent keeps its segment and colour).
+	 * @param agent_ Index of the agent.
+	 */
+	void resetAgent(size_t agent_);
+
+	/*!
+	 * Removes all agents.
+	 */
+	void clear();
+
+	/*!
+	 * Returns number of agents.
+	 */
+	size_t getAgents() const { return agents.size(); }
+
+	/*!
+	 * Returns length of the trajectory of a given agent.
+	 * @param agent_ Index of the agent.
+	 */
+	size_t getLength(size_t agent_) const;
+
+	/*!
+	 * Uploads appended positions and draws all trajectories, along with the current positions of agents.
+	 * @param scale_x_ Horizontal scale (pixels per unit).
+	 * @param scale_y_ Vertical scale (pixels per unit).
+	 * @param line_width_ Width of lines.
+	 */
+	void draw(float scale_x_, float scale_y_, float line_width_);
+
+private:
+	/*!
+	 * \brief Vertex stored in the buffer object.
+	 */
+	struct Vertex {
+		/// Coordinates.
+		GLfloat x, y;
+
+		/// Index of the position in the trajectory (texture coordinate of the colour ramp).
+		GLfloat step;
+
+		/// Colour of the agent.
+		uint32_t rgba;
+	};
+
+	/*!
+	 * \brief Segment of the buffer owned by an agent.
+	 */
+	struct Agent {
+		/// Index of the first vertex of the segment.
+		size_t offset;
+
+		/// Number of vertices reserved for the agent.
+		size_t capacity;
+
+		/// Length of the trajectory.
+		size_t count;
+
+		/// Number of vertices already uploaded to the buffer object.
+		size_t uploaded;
+
+		/// Colour of the agent.
+		uint32_t rgba;
+	};
+
+	/*!
+	 * Moves the trajectory of the agent to a new segment at the end of the buffer.
+	 * @param agent_ Agent.
+	 * @param capacity_ Capacity of the new segment.
+	 */
+	void relocate(Agent & agent_, size_t capacity_);
+
+	/*!
+	 * Removes segments that are not used anymore (left by relocated agents).
+	 */
+	void compact();
+
+	/*!
+	 * Uploads vertices that were not uploaded yet (the whole buffer if it must be reallocated).
+	 */
+	void upload();
+
+	/// Agents.
+	std::vector<Agent> agents;
+
+	/// Paths of agents (set by setPaths).
+	std::vector<std::shared_ptr<std::vector <mic::types::Position2D> > > paths;
+
+	/// Copy of the content of the buffer object.
+	std::vector<Vertex> vertices;
+
+	/// Number of vertices stored in segments owned by agents.
+	size_t used_vertices;
+
+	/// Id of the vertex buffer object.
+	GLuint buffer_id;
+
+	/// Number of vertices allocated in the buffer object.
+	size_t buffer_capacity;
+
+	/// Flag indicating that the whole buffer must be uploaded again.
+	bool buffer_outdated;
+
+	/// Initial number of positions reserved for every agent.
+	size_t initial_capacity;
+
+	/// Length of the longest trajectory.
+	size_t max_length;
+
+	/// Texture storing the brightness ramp.
+	Texture2D ramp;
+
+	/// Indices of the first vertices of trajectories (passed to glMultiDrawArrays).
+	std::vector<GLint> firsts;
+
+	/// Lengths of trajectories (passed to glMultiDrawArrays).
+	std::vector<GLsizei> counts;
+};
+
+} /* namespace visualization */
+} /* namespace opengl */
+} /* namespace mic */
+
+#endif /* SRC_OPENGL_VISUALIZATION_TRAJECTORYBUFFER_HPP_ */
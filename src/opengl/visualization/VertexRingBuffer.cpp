@@ -0,0 +1,125 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file VertexRingBuffer.cpp
+ * \brief Contains definitions of methods of the VertexRingBuffer class.
+ * \author tkornuta
+ * \date Oct 18, 2026
+ */
+
+#include <opengl/visualization/VertexRingBuffer.hpp>
+
+#include <algorithm>
+
+namespace mic {
+namespace opengl {
+namespace visualization {
+
+VertexRingBuffer::VertexRingBuffer(size_t capacity_) :
+		buffer_id(0), capacity(capacity_), head(0), count(0)
+{
+}
+
+VertexRingBuffer::~VertexRingBuffer() {
+	if (buffer_id != 0)
+		glDeleteBuffers(1, &buffer_id);
+}
+
+void VertexRingBuffer::reserve(size_t capacity_) {
+	capacity = capacity_;
+	// Drop the old buffer, new one will be allocated during the next append.
+	if (buffer_id != 0) {
+		glDeleteBuffers(1, &buffer_id);
+		buffer_id = 0;
+	}//: if
+	clear();
+}
+
+void VertexRingBuffer::clear() {
+	head = 0;
+	count = 0;
+}
+
+void VertexRingBuffer::append(const float* values_, size_t count_) {
+	if ((count_ == 0) || (capacity == 0))
+		return;
+
+	// Allocate the buffer: two copies of every slot (2 x capacity vertices, 2 coordinates each).
+	if (buffer_id == 0) {
+		glGenBuffers(1, &buffer_id);
+		glBindBuffer(GL_ARRAY_BUFFER, buffer_id);
+		glBufferData(GL_ARRAY_BUFFER, 2 * capacity * 2 * sizeof(GLfloat), NULL, GL_DYNAMIC_DRAW);
+	} else
+		glBindBuffer(GL_ARRAY_BUFFER, buffer_id);
+
+	// Only the last capacity values will survive - skip the rest.
+	if (count_ > capacity) {
+		values_ += (count_ - capacity);
+		count_ = capacity;
+	}//: if
+
+	// Write values in at most two contiguous runs: till the end of the ring and from its beginning.
+	size_t first_run = std::min(count_, capacity - head);
+	writeSlots(head, values_, first_run);
+	if (first_run < count_)
+		writeSlots(0, values_ + first_run, count_ - first_run);
+
+	head = (head + count_) % capacity;
+	count = std::min(count + count_, capacity);
+
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void VertexRingBuffer::writeSlots(size_t slot_, const float* values_, size_t count_) {
+	staging.resize(2 * count_);
+	// Lower half - x is equal to the slot index.
+	for (size_t i = 0; i < count_; i++) {
+		staging[2*i] = (GLfloat)(slot_ + i);
+		staging[2*i + 1] = values_[i];
+	}//: for
+	glBufferSubData(GL_ARRAY_BUFFER, 2 * slot_ * sizeof(GLfloat), staging.size() * sizeof(GLfloat), staging.data());
+
+	// Upper half - the same values shifted by capacity.
+	for (size_t i = 0; i < count_; i++)
+		staging[2*i] += (GLfloat)capacity;
+	glBufferSubData(GL_ARRAY_BUFFER, 2 * (slot_ + capacity) * sizeof(GLfloat), staging.size() * sizeof(GLfloat), staging.data());
+}
+
+float VertexRingBuffer::newestPosition() const {
+	// The newest value is always read from the upper half.
+	return (float)((head + capacity - 1) % capacity + capacity);
+}
+
+void VertexRingBuffer::drawLineStrip(size_t count_) {
+	count_ = std::min(count_, count);
+	if ((count_ == 0) || (buffer_id == 0))
+		return;
+
+	// Range of count_ vertices ending at the newest one - always contiguous.
+	size_t last = (size_t)newestPosition();
+	size_t first = last + 1 - count_;
+
+	glBindBuffer(GL_ARRAY_BUFFER, buffer_id);
+	glEnableClientState(GL_VERTEX_ARRAY);
+	glVertexPointer(2, GL_FLOAT, 0, 0);
+	glDrawArrays(GL_LINE_STRIP, (GLint)first, (GLsizei)count_);
+	glDisableClientState(GL_VERTEX_ARRAY);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+} /* namespace visualization */
+} /* namespace opengl */
+} /* namespace mic */
@@ -0,0 +1,123 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file VertexRingBuffer.hpp
+ * \brief Contains declaration of a GPU-resident ring buffer of line strip vertices.
+ * \author tkornuta
+ * \date Oct 18, 2026
+ */
+
+#ifndef SRC_OPENGL_VISUALIZATION_VERTEXRINGBUFFER_HPP_
+#define SRC_OPENGL_VISUALIZATION_VERTEXRINGBUFFER_HPP_
+
+#include <opengl/visualization/DrawingUtils.hpp>
+
+#include <vector>
+
+namespace mic {
+namespace opengl {
+namespace visualization {
+
+/*!
+ * \brief Ring buffer of 2D vertices stored in a vertex buffer object, used for streaming series of values (e.g. chart lines).
+ *
+ * Every value is stored twice - at slot i and at slot i+capacity - so the last n values always form a contiguous range of the buffer and can be drawn with a single call.
+ * The x coordinate of each vertex is equal to its slot index, the y coordinate is the raw value, hence the scrolling and scaling is done with the modelview transformation, without re-uploading the history.
+ * All methods (apart from getters) must be called from the thread owning the OpenGL context.
+ * \author tkornuta
+ */
+class VertexRingBuffer {
+public:
+	/*!
+	 * Constructor. Sets the capacity, the buffer object is created lazily (during the first append).
+	 * @param capacity_ Maximal number of stored values (DEFAULT=1024).
+	 */
+	VertexRingBuffer(size_t capacity_ = 1024);
+
+	/*!
+	 * Destructor. Releases the buffer object.
+	 */
+	virtual ~VertexRingBuffer();
+
+	/*!
+	 * Appends values to the buffer, overwriting the oldest ones when the buffer is full.
+	 * @param values_ Pointer to the appended values.
+	 * @param count_ Number of appended values.
+	 */
+	void append(const float* values_, size_t count_);
+
+	/*!
+	 * Removes all values from the buffer.
+	 */
+	void clear();
+
+	/*!
+	 * Changes capacity of the buffer. Content of the buffer is lost.
+	 * @param capacity_ New capacity.
+	 */
+	void reserve(size_t capacity_);
+
+	/*!
+	 * Draws the last (i.e. newest) values as a single line strip.
+	 * @param count_ Number of drawn values (limited by the number of stored values).
+	 */
+	void drawLineStrip(size_t count_);
+
+	/*!
+	 * Returns the x coordinate of the newest vertex, used for computation of the scrolling transformation.
+	 */
+	float newestPosition() const;
+
+	/*!
+	 * Returns number of values stored in the buffer.
+	 */
+	size_t size() const { return count; }
+
+	/*!
+	 * Returns capacity of the buffer.
+	 */
+	size_t getCapacity() const { return capacity; }
+
+private:
+	/*!
+	 * Writes vertices to a given (contiguous) range of slots, both in the lower and in the upper half of the buffer.
+	 * @param slot_ Index of the first slot (in the lower half).
+	 * @param values_ Pointer to the values.
+	 * @param count_ Number of values.
+	 */
+	void writeSlots(size_t slot_, const float* values_, size_t count_);
+
+	/// Id of the vertex buffer object.
+	GLuint buffer_id;
+
+	/// Capacity of the buffer (number of values).
+	size_t capacity;
+
+	/// Index of slot in which the next value will be stored.
+	size_t head;
+
+	/// Number of stored values.
+	size_t count;
+
+	/// Staging buffer with interleaved (x,y) coordinates of vertices being uploaded.
+	std::vector<GLfloat> staging;
+};
+
+} /* namespace visualization */
+} /* namespace opengl */
+} /* namespace mic */
+
+#endif /* SRC_OPENGL_VISUALIZATION_VERTEXRINGBUFFER_HPP_ */
@@ -46,6 +46,8 @@ Window::Window(std::string name_, unsigned int position_x_, unsigned int positio
     glutReshapeFunc(VGL_MANAGER->reshapeHandler);
     glutKeyboardFunc(VGL_MANAGER->keyboardHandler);
     glutMouseFunc(VGL_MANAGER->mouseHandler);
+    glutMotionFunc(VGL_MANAGER->motionHandler);
+    glutPassiveMotionFunc(VGL_MANAGER->passiveMotionHandler);
     
     // Set OpenGl antialiasing parameters.
     glEnable(GL_LINE_SMOOTH);
@@ -62,6 +64,9 @@ Window::Window(std::string name_, unsigned int position_x_, unsigned int positio
 	// Set fullscreen mode to off.
 	fullscreen_mode = false;
 
+	// Initialize the cached viewport with the requested size (till the first reshape).
+	setViewport(width, height);
+
 	// Register default key handlers.
 	REGISTER_KEY_HANDLER('f', "f - toggles fullscreen on/off", &Window::keyhandlerFullscreen);
 
@@ -89,6 +94,9 @@ void Window::reshapeHandler(int width_, int height_){
 	height = height_;
 	width = width_;
 
+	// Update the cached viewport - used during drawing instead of querying GLUT.
+	setViewport(width, height);
+
 	// Change window size.
     glViewport(0, 0, width, height);
     glMatrixMode(GL_PROJECTION);
@@ -91,6 +91,20 @@ public:
 	 */
 	virtual void mouseHandler(int button, int state, int x, int y) { };
 
+	/*!
+	 * Mouse motion (with a pressed button) handler - virtual method, to be overridden if necessary.
+	 * @param x X coordinate of the mouse pointer.
+	 * @param y Y coordinate of the mouse pointer.
+	 */
+	virtual void motionHandler(int x, int y) { };
+
+	/*!
+	 * Mouse motion (without pressed buttons) handler - virtual method, to be overridden if necessary.
+	 * @param x X coordinate of the mouse pointer.
+	 * @param y Y coordinate of the mouse pointer.
+	 */
+	virtual void passiveMotionHandler(int x, int y) { };
+
 	/*!
 	 * Changes size of the window.
 	 * @param width_ New width.
@@ -29,6 +29,8 @@
 
 #include <utils/DataCollector.hpp>
 
+#include <opengl/visualization/VertexRingBuffer.hpp>
+
 namespace mic {
 namespace opengl {
 namespace visualization {
@@ -49,7 +51,9 @@ public:
 			unsigned int position_x_ = 0, unsigned int position_y_ = 0,
 			unsigned int width_ = 1024, unsigned int height_ = 256) :
 		Window(name_, position_x_, position_y_, width_, height_),
-		collector_ptr(nullptr)
+		collector_ptr(nullptr),
+		chrome_display_list(0),
+		chrome_valid(false)
 	{
 		// Set default values of variables.
 		zoom_factor = 1.0f;
@@ -74,9 +78,22 @@ public:
 
 
 	/*!
-	 * Destructor. Empty for now.
+	 * Destructor. Releases the display list storing the chart chrome.
 	 */
-	virtual ~WindowCollectorChart() { }
+	virtual ~WindowCollectorChart() {
+		if (chrome_display_list != 0)
+			glDeleteLists(chrome_display_list, 1);
+	}
+
+	/*!
+	 * Changes size of the window and invalidates the cached chart chrome (frame, bars and labels depend on the window size).
+	 * @param width_ New width.
+	 * @param height_ New height.
+	 */
+	virtual void reshapeHandler(int width_, int height_) {
+		Window::reshapeHandler(width_, height_);
+		chrome_valid = false;
+	}
 
 	/*!
 	 * Refreshes the content of the window.
@@ -107,8 +124,8 @@ public:
 				// Get vector.
 				std::string l =  it->first;
 
-				// Get data.
-				std::vector<eT> vector = (it->second)->data;
+				// Get data (by reference - the history is not copied every frame).
+				std::vector<eT> & vector = (it->second)->data;
 				// Get min-max values.
 				eT min_value = (it->second)->min_value;
 				eT max_value = (it->second)->max_value;
@@ -123,7 +140,7 @@ public:
 				int acc_y = (int)(label_offset_y);
 				int acc_h = (int)(height * chart_height);
 				//std::cout << acc_y + acc_h + label_y_offset << std::endl;
-				if (acc_y + acc_h + label_y_offset > (unsigned int) glutGet((GLenum) GLUT_WINDOW_HEIGHT)) {
+				if (acc_y + acc_h + label_y_offset > (unsigned int) viewport_height) {
 					label_y_offset = 15;
 					label_x_offset += 200;
 				}//: if
@@ -131,7 +148,13 @@ public:
 				// Draw chart associated with given data container.
 				redrawSingleContainer(l, vector, min_value, max_value, c, line_width, label_x_offset, label_y_offset);
 			}//: end
-		}//: if !null
+
+			// Release buffers of series whose containers were removed (or renamed).
+			releaseStaleSeriesBuffers(containers);
+		} else {
+			// No collector - release all buffers.
+			series_buffers.clear();
+		}//: else
 
 		// Swap buffers.
 		glutSwapBuffers();
@@ -152,11 +175,31 @@ public:
 	}
 
 	/*!
-	 * Redraws main chart window.
+	 * Redraws main chart window. The static chrome (frame, horizontal bars and percentage labels) is compiled into a display list once and then only replayed, until the layout changes.
 	 */
 	void redrawMainChartWindow() {
 		LOG(LTRACE)<< "WindowFloatCollectorChart::refreshChart";
 
+		if (!chrome_valid) {
+			// Generate display list - done once, as the list is reused in the consecutive recompilations.
+			if (chrome_display_list == 0)
+				chrome_display_list = glGenLists(1);
+
+			// Compile the chart chrome into display list.
+			glNewList(chrome_display_list, GL_COMPILE);
+			drawChartChrome();
+			glEndList();
+			chrome_valid = true;
+		}//: if
+
+		// Replay the chrome.
+		glCallList(chrome_display_list);
+	}
+
+	/*!
+	 * Draws the static chart chrome: boundaries of chart and labels area, horizontal bars and percentage labels.
+	 */
+	void drawChartChrome() {
 		int acc_x = (int)(width * ((1.0 - chart_width)/2.0));
 		int acc_y = (int)(label_offset_y);
 		int acc_w = (int)(width * chart_width);
@@ -203,9 +246,6 @@ public:
 		int acc_w = (int)(width * chart_width);
 		int acc_h = (int)(height * chart_height);
 
-		// Set line width.
-		glLineWidth(line_width_);
-		glBegin(GL_LINE_STRIP);
 		eT value;
 		// Special case: division by 0. Place values in the "middle" (0.5).
 		eT diff = max_value_ - min_value_;
@@ -213,19 +253,22 @@ public:
 			diff = 0.5;
 			min_value_ = 0.0;
 		}
-		// Draw data.
-		for (int i = 0; i < chart_width * (width); i++) {
 
-			if (data_.size() - 1 - (size_t)round(i * zoom_factor) < data_.size()) {
-				value = data_[data_.size() - 1 - (size_t)(i * zoom_factor)];
-				// Scale the value.
-				value = (value - min_value_)/(diff);
-				glColor4f(color_.r/255.0f, color_.g/255.0f, color_.b/255.0f, color_.a/255.0f);
-				glVertex2i(acc_x + acc_w - (int)(i), acc_y + acc_h - (int)(value * acc_h));
-			}
+		// Number of samples fitting in the chart (depends on zoom).
+		size_t visible = std::min(data_.size(), (size_t)(acc_w * zoom_factor) + 1);
 
-		}
-		glEnd();
+		// Upload new samples to the series buffer.
+		std::shared_ptr<VertexRingBuffer> buffer = synchronizeSeriesBuffer(label_, data_, visible);
+
+		// Draw the visible history with a single call - scrolling and scaling is done by the transformation:
+		// x = right border - (newest - slot)/zoom, y = bottom border - (value - min)/diff * height.
+		glPushMatrix();
+		glTranslatef(acc_x + acc_w - buffer->newestPosition() / zoom_factor, acc_y + acc_h + (float)(min_value_ / diff) * acc_h, 0.0f);
+		glScalef(1.0f / zoom_factor, -(float)acc_h / (float)diff, 1.0f);
+		glLineWidth(line_width_);
+		glColor4f(color_.r/255.0f, color_.g/255.0f, color_.b/255.0f, color_.a/255.0f);
+		buffer->drawLineStrip(visible);
+		glPopMatrix();
 
 		// Print label.
 		char str_value[100] = "-";
@@ -241,6 +284,74 @@ public:
 
 private:
 
+	/*!
+	 * Returns buffer associated with a given series, appending to it samples that appeared since the last synchronization.
+	 * @param label_ Label of data.
+	 * @param data_ Vector containing data.
+	 * @param visible_ Number of samples that must fit in the buffer.
+	 * @return Synchronized buffer.
+	 */
+	std::shared_ptr<VertexRingBuffer> synchronizeSeriesBuffer(const std::string & label_, const std::vector<eT> & data_, size_t visible_) {
+		SeriesBuffer & series = series_buffers[label_];
+		if (series.buffer == nullptr) {
+			series.buffer = std::make_shared<VertexRingBuffer>();
+			series.uploaded = 0;
+		}//: if
+
+		// Data container was reset - start from scratch.
+		if (data_.size() < series.uploaded) {
+			series.buffer->clear();
+			series.uploaded = 0;
+		}//: if
+
+		// Grow the buffer (to the next power of two) when zoomed out beyond its capacity, then reload it from the history.
+		if (visible_ > series.buffer->getCapacity()) {
+			size_t capacity = series.buffer->getCapacity();
+			while (capacity < visible_)
+				capacity *= 2;
+			series.buffer->reserve(capacity);
+			series.uploaded = 0;
+		}//: if
+
+		// Append only the new samples (at most capacity of them).
+		size_t first = std::max(series.uploaded, data_.size() - std::min(data_.size(), series.buffer->getCapacity()));
+		if (first < data_.size()) {
+			std::vector<float> samples(data_.begin() + first, data_.end());
+			series.buffer->append(samples.data(), samples.size());
+		}//: if
+		series.uploaded = data_.size();
+
+		return series.buffer;
+	}
+
+	/*!
+	 * Releases buffers of series that are not present in the data collector anymore.
+	 * @param containers_ Data containers of the collector.
+	 */
+	void releaseStaleSeriesBuffers(const mic::utils::DataContainers<std::string, eT> & containers_) {
+		typename std::map<std::string, SeriesBuffer>::iterator it = series_buffers.begin();
+		while (it != series_buffers.end()) {
+			if (containers_.find(it->first) == containers_.end())
+				series_buffers.erase(it++);
+			else
+				++it;
+		}//: while
+	}
+
+	/*!
+	 * Structure storing GPU buffer of a single series along with the number of samples already uploaded.
+	 */
+	struct SeriesBuffer {
+		/// Ring buffer with the most recent samples.
+		std::shared_ptr<VertexRingBuffer> buffer;
+
+		/// Number of samples of the data container uploaded to the buffer.
+		size_t uploaded;
+	};
+
+	/// Buffers of series, indexed by labels of data containers.
+	std::map<std::string, SeriesBuffer> series_buffers;
+
 	/// Data collector associated with .
 	mic::utils::DataCollectorPtr<std::string, eT> collector_ptr;
 
@@ -262,6 +373,12 @@ private:
 	/// Number of horizontal bars in chart.
 	double number_of_horizontal_bars;
 
+	/// Display list storing the static chart chrome (frame, horizontal bars and percentage labels).
+	GLuint chrome_display_list;
+
+	/// Flag indicating whether the chrome display list is up to date with the current layout.
+	bool chrome_valid;
+
 	/*!
 	 *  Keyhandler: zoom in (upscale chart).
 	 */
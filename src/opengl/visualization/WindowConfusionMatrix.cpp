@@ -0,0 +1,182 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file WindowConfusionMatrix.cpp
+ * \brief Contains definition of a window displaying confusion matrix of a classifier.
+ * \author tkornuta
+ * \date Oct 18, 2026
+ */
+
+#include <opengl/visualization/WindowConfusionMatrix.hpp>
+#include <opengl/visualization/WindowManager.hpp>
+
+#include <algorithm>
+
+namespace mic {
+namespace opengl {
+namespace visualization {
+
+// Static members.
+boost::atomic<size_t> WindowConfusionMatrix::next_window_id(0);
+boost::thread_specific_ptr<std::map<size_t, WindowConfusionMatrix::Accumulator*> > WindowConfusionMatrix::local_accumulators;
+
+WindowConfusionMatrix::WindowConfusionMatrix(std::string name_,
+		unsigned int position_x_, unsigned int position_y_,
+		unsigned int width_ , unsigned int height_,
+		size_t number_of_classes_) :
+	WindowMatrix2D(name_, position_x_, position_y_, width_, height_),
+	number_of_classes(0),
+	number_of_samples(0),
+	number_of_correct(0),
+	counts_epoch(0),
+	window_id(next_window_id++)
+{
+	setNumberOfClasses(number_of_classes_);
+
+	// Register additional key handler.
+	REGISTER_KEY_HANDLER('c', "c - resets counts", &WindowConfusionMatrix::keyhandlerClear);
+}
+
+
+WindowConfusionMatrix::~WindowConfusionMatrix() {
+	// Accumulators are released along with the window - entries of other threads are left, but never accessed again.
+	if (local_accumulators.get() != nullptr)
+		local_accumulators->erase(window_id);
+}
+
+
+WindowConfusionMatrix::Accumulator* WindowConfusionMatrix::localAccumulator() {
+	// Accumulators of the thread (released when the thread exits).
+	if (local_accumulators.get() == nullptr)
+		local_accumulators.reset(new std::map<size_t, Accumulator*>());
+	Accumulator* & accumulator = (*local_accumulators)[window_id];
+	if (accumulator == nullptr) {
+		// First call from this thread - register a new accumulator.
+		boost::mutex::scoped_lock lock(accumulators_mutex);
+		accumulators.push_back(std::make_shared<Accumulator>());
+		accumulator = accumulators.back().get();
+		accumulator->epoch = counts_epoch;
+	}//: if
+
+	// Counts were reset - drop pairs accumulated before.
+	size_t epoch = counts_epoch.load(boost::memory_order_acquire);
+	if (accumulator->epoch != epoch) {
+		accumulator->cells.clear();
+		accumulator->epoch = epoch;
+	}//: if
+	return accumulator;
+}
+
+
+void WindowConfusionMatrix::addPrediction(size_t label_, size_t prediction_) {
+	if ((label_ >= number_of_classes) || (prediction_ >= number_of_classes))
+		return;
+	localAccumulator()->cells.push_back((uint32_t)(label_ * number_of_classes + prediction_));
+}
+
+
+void WindowConfusionMatrix::addPredictions(const std::vector<size_t> & labels_, const std::vector<size_t> & predictions_) {
+	Accumulator* accumulator = localAccumulator();
+	size_t size = std::min(labels_.size(), predictions_.size());
+	for (size_t i = 0; i < size; i++)
+		if ((labels_[i] < number_of_classes) && (predictions_[i] < number_of_classes))
+			accumulator->cells.push_back((uint32_t)(labels_[i] * number_of_classes + predictions_[i]));
+}
+
+
+void WindowConfusionMatrix::publishSynchronized() {
+	// Enter critical section.
+	APP_DATA_SYNCHRONIZATION_SCOPED_LOCK();
+	publishUnsynchronized();
+	// End of critical section.
+}
+
+
+void WindowConfusionMatrix::publishUnsynchronized() {
+	// Merge accumulators - O(number of added pairs).
+	{
+		boost::mutex::scoped_lock lock(accumulators_mutex);
+		for (size_t a = 0; a < accumulators.size(); a++) {
+			std::vector<uint32_t> & cells = accumulators[a]->cells;
+			// Counts were reset after the pairs were accumulated - drop them.
+			if (accumulators[a]->epoch != counts_epoch) {
+				cells.clear();
+				accumulators[a]->epoch = counts_epoch;
+				continue;
+			}//: if
+			for (size_t i = 0; i < cells.size(); i++) {
+				size_t label = cells[i] / number_of_classes;
+				counts[cells[i]]++;
+				row_totals[label]++;
+				changed_rows[label] = true;
+				if (cells[i] % number_of_classes == label)
+					number_of_correct++;
+			}//: for
+			number_of_samples += cells.size();
+			cells.clear();
+		}//: for
+	}
+
+	// Normalize the changed rows.
+	mic::types::MatrixXf & normalized = *normalized_ptr;
+	for (size_t row = 0; row < number_of_classes; row++) {
+		if (!changed_rows[row])
+			continue;
+		float scale = 1.0f / (float)row_totals[row];
+		const uint32_t* row_counts = &counts[row * number_of_classes];
+		for (size_t col = 0; col < number_of_classes; col++)
+			normalized(row, col) = (float)row_counts[col] * scale;
+		changed_rows[row] = false;
+	}//: for
+
+	setMatrixPointerUnsynchronized(normalized_ptr);
+}
+
+
+void WindowConfusionMatrix::setNumberOfClasses(size_t number_of_classes_) {
+	// Enter critical section.
+	APP_DATA_SYNCHRONIZATION_SCOPED_LOCK();
+	number_of_classes = number_of_classes_;
+	resetCounts();
+	// End of critical section.
+}
+
+
+void WindowConfusionMatrix::keyhandlerClear(void) {
+	// Enter critical section.
+	APP_DATA_SYNCHRONIZATION_SCOPED_LOCK();
+	resetCounts();
+	// End of critical section.
+}
+
+
+void WindowConfusionMatrix::resetCounts() {
+	counts.assign(number_of_classes * number_of_classes, 0);
+	row_totals.assign(number_of_classes, 0);
+	changed_rows.assign(number_of_classes, false);
+	number_of_samples = 0;
+	number_of_correct = 0;
+	// Accumulators can be filled by other threads right now - pairs accumulated before the reset are dropped by their threads or during the next publication.
+	counts_epoch++;
+
+	normalized_ptr = MAKE_MATRIX_PTR(float, number_of_classes, number_of_classes);
+	normalized_ptr->setZero();
+	setMatrixPointerUnsynchronized(normalized_ptr);
+}
+
+} /* namespace visualization */
+} /* namespace opengl */
+} /* namespace mic */
@@ -0,0 +1,183 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file WindowConfusionMatrix.hpp
+ * \brief Contains declaration of a window displaying confusion matrix of a classifier.
+ * \author tkornuta
+ * \date Oct 18, 2026
+ */
+
+#ifndef SRC_OPENGL_VISUALIZATION_WINDOWCONFUSIONMATRIX_HPP_
+#define SRC_OPENGL_VISUALIZATION_WINDOWCONFUSIONMATRIX_HPP_
+
+#include <opengl/visualization/WindowMatrix2D.hpp>
+
+#include <boost/atomic.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/tss.hpp>
+
+#include <map>
+#include <memory>
+#include <stdint.h>
+#include <vector>
+
+namespace mic {
+namespace opengl {
+namespace visualization {
+
+/*!
+ * \brief OpenGL-based window displaying confusion matrix of a classifier - rows correspond to labels, columns to predictions, every row is normalized by the number of samples of its label.
+ *
+ * Label/prediction pairs are added to per-thread accumulators without locking (e.g. by threads testing different parts of the test set) and merged into counts when the matrix is published.
+ * Only the rows of labels that appeared since the last publication are normalized again.
+ * The normalized matrix is displayed by WindowMatrix2D, i.e. as a level-of-detail pyramid of textures, so it scales to thousands of classes.
+ * \author tkornuta
+ */
+class WindowConfusionMatrix: public WindowMatrix2D {
+public:
+	/*!
+	 * Constructor.
+	 * @param number_of_classes_ Number of classes.
+	 */
+	WindowConfusionMatrix(std::string name_ = "ConfusionMatrix",
+			unsigned int position_x_ = 0, unsigned int position_y_ = 0,
+			unsigned int width_ = 512, unsigned int height_ = 512,
+			size_t number_of_classes_ = 10);
+
+	/*!
+	 * Destructor.
+	 */
+	virtual ~WindowConfusionMatrix();
+
+	/*!
+	 * Adds label/prediction pair to the accumulator of the calling thread (lock-free, pairs out of range of classes are ignored).
+	 * @param label_ Label (true class).
+	 * @param prediction_ Predicted class.
+	 */
+	void addPrediction(size_t label_, size_t prediction_);
+
+	/*!
+	 * Adds label/prediction pairs of a batch to the accumulator of the calling thread (lock-free).
+	 * @param labels_ Labels (true classes).
+	 * @param predictions_ Predicted classes.
+	 */
+	void addPredictions(const std::vector<size_t> & labels_, const std::vector<size_t> & predictions_);
+
+	/*!
+	 * Merges accumulators into counts and publishes the normalized matrix.
+	 * Must not be called concurrently with adding of pairs (e.g. after all testing threads finished a batch).
+	 */
+	void publishSynchronized();
+
+	/*!
+	 * Merges accumulators into counts and publishes the normalized matrix. Unsynchronized i.e. must be used inside of manually synchronized section.
+	 */
+	void publishUnsynchronized();
+
+	/*!
+	 * Changes number of classes - resets counts.
+	 * Must not be called concurrently with adding of pairs (pairs are encoded using the number of classes).
+	 * @param number_of_classes_ Number of classes.
+	 */
+	void setNumberOfClasses(size_t number_of_classes_);
+
+	/*!
+	 * Resets counts. Pairs accumulated (but not published) before the reset are discarded.
+	 */
+	void keyhandlerClear(void);
+
+	/*!
+	 * Returns number of classes.
+	 */
+	size_t getNumberOfClasses() const { return number_of_classes; }
+
+	/*!
+	 * Returns number of published pairs.
+	 */
+	size_t getNumberOfSamples() const { return number_of_samples; }
+
+	/*!
+	 * Returns accuracy of published pairs (ratio of pairs with correct predictions).
+	 */
+	float getAccuracy() const { return (number_of_samples > 0) ? (float)number_of_correct / number_of_samples : 0.0f; }
+
+private:
+	/*!
+	 * \brief Accumulator of pairs added by a single thread.
+	 */
+	struct Accumulator {
+		/// Indices of cells (label * number_of_classes + prediction) of added pairs.
+		std::vector<uint32_t> cells;
+
+		/// Epoch of counts the pairs were added in.
+		size_t epoch;
+	};
+
+	/*!
+	 * Returns accumulator of the calling thread (creates it during the first call from a given thread).
+	 */
+	Accumulator* localAccumulator();
+
+	/*!
+	 * Resets counts and publishes empty matrix. Accumulators are not touched (they can be filled by other threads) - instead the epoch of counts is advanced, so pairs accumulated before are discarded.
+	 */
+	void resetCounts();
+
+	/// Number of classes.
+	size_t number_of_classes;
+
+	/// Counts of pairs (label-major).
+	std::vector<uint32_t> counts;
+
+	/// Numbers of pairs of labels.
+	std::vector<uint64_t> row_totals;
+
+	/// Flags indicating rows that changed since the last publication.
+	std::vector<bool> changed_rows;
+
+	/// Number of published pairs.
+	size_t number_of_samples;
+
+	/// Number of published pairs with correct predictions.
+	size_t number_of_correct;
+
+	/// Epoch of counts, advanced on every reset.
+	boost::atomic<size_t> counts_epoch;
+
+	/// Row-normalized confusion matrix.
+	mic::types::MatrixXfPtr normalized_ptr;
+
+	/// Unique id of the window (ids are never reused).
+	const size_t window_id;
+
+	/// Accumulators of all threads (owned by the window).
+	std::vector<std::shared_ptr<Accumulator> > accumulators;
+
+	/// Mutex protecting the list of accumulators (locked only during registration of a thread and merging).
+	boost::mutex accumulators_mutex;
+
+	/// Id assigned to the next created window.
+	static boost::atomic<size_t> next_window_id;
+
+	/// Accumulators of the calling thread, keyed by ids of windows (not owned). Shared by all windows, so destroyed windows cannot leave stale per-window slots in other threads.
+	static boost::thread_specific_ptr<std::map<size_t, Accumulator*> > local_accumulators;
+};
+
+} /* namespace visualization */
+} /* namespace opengl */
+} /* namespace mic */
+
+#endif /* SRC_OPENGL_VISUALIZATION_WINDOWCONFUSIONMATRIX_HPP_ */
@@ -27,6 +27,14 @@
 
 #include <opengl/visualization/Window.hpp>
 #include <opengl/visualization/WindowManager.hpp>
+#include <opengl/visualization/Grayscale.hpp>
+#include <opengl/visualization/Colormap.hpp>
+#include <opengl/visualization/NormalizationShader.hpp>
+#include <opengl/visualization/Texture2D.hpp>
+#include <opengl/visualization/WorkerPool.hpp>
+#include <opengl/visualization/FramePipeline.hpp>
+
+#include <boost/bind.hpp>
 
 // Dependencies on core types.
 #include <types/MNISTTypes.hpp>
@@ -35,71 +43,6 @@ namespace mic {
 namespace opengl {
 namespace visualization {
 
-/*!
- * \brief Class containing enumerators used in grayscale windows.
- * \author tkornuta
- */
-class Grayscale {
-public:
-
-	/*!
-	 * Normalization of the grayscale (single channel) images.
-	 */
-	enum Normalization {
-		Norm_None, //< Display original image(s), without any normalization (negative values simply won't be visible).
-		Norm_Positive, //< Display image(s) normalized to <0,1>.
-		Norm_HotCold, //< Display image(s) in a hot-cold normalization <-1,1> i.e. red are positive and blue are negative values.
-		Norm_TensorFLow //< Display image(s) in a inverted hot-cold normalization <-1,1> i.e. red are negative and blue are positive values.
-	};
-
-	/*!
-	 * Method returning description of a given type of normalization.
-	 */
-	std::string norm2str(Normalization norm_)
-	{
-		switch(norm_) {
-		case(Norm_None):
-			return "Display original image(s), without any normalization";
-		case(Norm_Positive):
-			return "Display image(s) normalized to <0,1>";
-		case(Norm_HotCold):
-			return "Display image(s) in a hot-cold normalization <-1,1> i.e. red are positive and blue are negative";
-		case(Norm_TensorFLow):
-			return "Display inverted hot-cold normalization <-1,1> i.e. red are negative and blue are positive";
-		}
-		return "UNDEFINED";
-	}
-
-	/*!
-	 * Types of grids to be displayed.
-	 */
-	enum Grid {
-		Grid_None, //< No grid
-		Grid_Sample, //< Display only grid dividing sample cells.
-		Grid_Batch, //< Display grid dividing samples.
-		Grid_Both //< Display both sample and batch grids.
-	};
-
-	/*!
-	 * Method returning description of a given grid display mode.
-	 */
-	std::string grid2str(Grid grid_)
-	{
-		switch(grid_) {
-		case(Grid_None):
-			return "Display no grid";
-		case(Grid_Sample):
-			return "Display only grid dividing sample cells";
-		case(Grid_Batch):
-			return "Display grid dividing samples";
-		case(Grid_Both):
-			return "Display both sample and batch grids";
-		}
-		return "UNDEFINED";
-	}
-
-};
-
 /*!
  * \brief OpenGL-based window responsible for displaying grayscale (singlechannel) batch in a window.
  * \author tkornuta
@@ -119,11 +62,15 @@ public:
 			bool draw_batch_grid_ = true, bool draw_sample_grid_ = false) :
 		Window(name_, position_x_, position_y_, width_, height_),
 		normalization(normalization_ ),
-		grid(grid_)
+		grid(grid_),
+		displayed_colormapped(false),
+		batch_published(false),
+		pipeline(boost::bind(&WindowGrayscaleBatch<eT>::prepareFrame, this, _1))
 	{
 		// Register additional key handler.
 		REGISTER_KEY_HANDLER('n', "n - toggles normalization mode", &WindowGrayscaleBatch<eT>::keyhandlerToggleNormalizationMode);
 		REGISTER_KEY_HANDLER('g', "g - toggles grid mode", &WindowGrayscaleBatch<eT>::keyhandlerGridMode);
+		REGISTER_KEY_HANDLER('m', "m - toggles colormap", &WindowGrayscaleBatch<eT>::keyhandlerToggleColormap);
 	}
 
 	/*!
@@ -153,6 +100,19 @@ public:
 		// End of critical section.
 	}
 
+	/*!
+	 * Changes colormap.
+	 */
+	void keyhandlerToggleColormap(void) {
+		// Enter critical section.
+		APP_DATA_SYNCHRONIZATION_SCOPED_LOCK();
+		colormap.setType((ColormapType)((colormap.getType() + 1) % Colormap_Count));
+		// Textures must be recoloured.
+		batch_published = true;
+		LOG(LINFO) << Colormap::colormap2str(colormap.getType());
+		// End of critical section.
+	}
+
 	/*!
 	 * Refreshes the content of the window.
 	 */
@@ -179,73 +139,55 @@ public:
 			size_t cols = batch_data[0]->cols();
 
 			// Set opengl scale related variables.
-	    	eT scale_x = (eT)glutGet(GLUT_WINDOW_WIDTH)/(eT)(cols * batch_width);
-	    	eT scale_y = (eT)glutGet(GLUT_WINDOW_HEIGHT)/(eT)(rows * batch_height);
+	    	eT scale_x = (eT)viewport_width/(eT)(cols * batch_width);
+	    	eT scale_y = (eT)viewport_height/(eT)(rows * batch_height);
+
+			// Colormaps are applied on the CPU once per publication, otherwise colour on the GPU if possible - raw data is uploaded only once per publication.
+			bool use_colormap = (colormap.getType() != Colormap_None);
+			bool use_shader = !use_colormap && shader.build();
+			if (use_colormap || use_shader) {
+				// Textures are prepared in the background once per publication.
+				if (batch_published)
+					submitFrame(rows, cols, use_colormap);
+				std::shared_ptr<Frame> frame = pipeline.takePrepared();
+				if (frame != nullptr)
+					uploadFrame(*frame);
+			}//: if
 
 	    	// Iterate through batch elements.
 			for (size_t by=0; by < batch_height; by++)
 				for (size_t bx=0; bx < batch_width; bx++) {
 					// Check if we do not excess size.
-					if ((by*batch_width + bx) >= batch_data.size())
+					size_t i = by*batch_width + bx;
+					if (i >= batch_data.size())
 						break;
-					// Get pointer to a given image.
-					eT* data_ptr = batch_data[by*batch_width + bx]->data();
-
-					// Calculate mins and max - for visualization.
-					eT min =  std::numeric_limits<double>::max();
-					eT max =  std::numeric_limits<double>::min();
-					// Find min and max.
-					for(size_t i=0; i< rows*cols; i++) {
-						min = (min > data_ptr[i]) ? data_ptr[i] : min;
-						max = (max < data_ptr[i]) ? data_ptr[i] : max;
-					}//: for
-					// Check whether we can normalize.
-					eT diff = max - min;
-					if (diff == 0.0f) {
-						min = max = 0.0;
-						diff = 1.0f;
-					}
-
-					//eT ultimate_max= (max > -min) ? max : -min;
-
-				   	// Iterate through matrix elements.
-					for (size_t y = 0; y < rows; y++) {
-						for (size_t x = 0; x < cols; x++) {
-							// Get value - REVERSED! as Eigen::Matrix by default is column-major!!
-							eT val = data_ptr[x*rows + y];
-							eT red, green, blue, alpha;
-
-							// Color depending on the visualization.
-							switch(normalization) {
-							case Normalization::Norm_Positive:
-								red = green = blue = (val - min)/diff;
-								alpha = 1.0f;
-								break;
-							case Normalization::Norm_HotCold:
-								red = (val > 0.0) ? val/max : 0.0f;
-								green = 0.0f;
-								blue = (val < 0.0) ? val/min : 0.0f;
-								alpha = 1.0f;
-								break;
-							case Normalization::Norm_TensorFLow:
-								blue = (val > 0.0) ? val/max : 0.0f;
-								green = 0.0f;
-								red = (val < 0.0) ? val/min : 0.0f;
-								alpha = 1.0f;
-								break;
-							// None is default.
-							case Normalization::Norm_None:
-							default:
-								red = green = blue = alpha = val/diff;
-								break;
-							}//: switch
-
-							// Draw rectangle - (x, y, height, width, color)!!
-							draw_filled_rectangle(eT(bx*cols+x) * scale_x, eT(by*rows+y) * scale_y, scale_y, scale_x,
-									red, green, blue, alpha);
-
-						}//: for
-					}//: for
+
+					if (use_colormap || use_shader) {
+						// Texture is not ready yet.
+						if (i >= textures.size())
+							break;
+					} else {
+						drawSampleImmediate(batch_data[i]->data(), rows, cols, bx, by, scale_x, scale_y);
+						continue;
+					}//: else
+
+					if (displayed_colormapped) {
+						// Texture already stores colours.
+						glEnable(GL_TEXTURE_2D);
+						glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_REPLACE);
+						textures[i]->bind();
+						textures[i]->draw(eT(bx*cols) * scale_x, eT(by*rows) * scale_y, rows * scale_y, cols * scale_x, 0.0f, 0.0f, 1.0f, 1.0f, true);
+						textures[i]->unbind();
+						glDisable(GL_TEXTURE_2D);
+					} else if (shader.build()) {
+						// Normalization is just a uniform.
+						shader.useGrayscale(normalization, sample_min[i], sample_max[i]);
+						textures[i]->bind();
+						// Texture stores the column-major matrix (rows x cols), hence it is drawn transposed.
+						textures[i]->draw(eT(bx*cols) * scale_x, eT(by*rows) * scale_y, rows * scale_y, cols * scale_x, 0.0f, 0.0f, 1.0f, 1.0f, true);
+						textures[i]->unbind();
+						shader.release();
+					}//: else
 
 				}//: for images in batch
 
@@ -287,6 +229,7 @@ public:
 		batch_data.clear();
 		// Add sample.
 		batch_data.push_back(sample_ptr_);
+		batch_published = true;
 
 		// End of critical section.
 	}
@@ -300,6 +243,7 @@ public:
 		batch_data.clear();
 		// Add sample.
 		batch_data.push_back(sample_ptr_);
+		batch_published = true;
 	}
 	/*!
 	 * Sets displayed batch.
@@ -310,6 +254,7 @@ public:
 		APP_DATA_SYNCHRONIZATION_SCOPED_LOCK();
 
 		batch_data = batch_data_;
+		batch_published = true;
 
 		// End of critical section.
 	}
@@ -320,11 +265,174 @@ public:
 	 */
 	void setBatchUnsynchronized(std::vector <std::shared_ptr<mic::types::Matrix<eT> > > & batch_data_) {
 		batch_data = batch_data_;
+		batch_published = true;
 	}
 
 
 private:
 
+	/*!
+	 * Finds minimal and maximal value of a given sample.
+	 * @param data_ptr_ Pointer to data.
+	 * @param size_ Number of elements.
+	 * @param min_ Returned min value.
+	 * @param max_ Returned max value.
+	 */
+	static void findMinMax(const eT* data_ptr_, size_t size_, eT & min_, eT & max_) {
+		min_ =  std::numeric_limits<double>::max();
+		max_ =  std::numeric_limits<double>::min();
+		for(size_t i=0; i< size_; i++) {
+			min_ = (min_ > data_ptr_[i]) ? data_ptr_[i] : min_;
+			max_ = (max_ < data_ptr_[i]) ? data_ptr_[i] : max_;
+		}//: for
+	}
+
+	/*!
+	 * \brief Structure representing a frame passing through the pipeline - snapshot of the published batch and data prepared from it.
+	 */
+	struct Frame {
+		/// Number of rows of a sample.
+		size_t rows;
+
+		/// Number of columns of a sample.
+		size_t cols;
+
+		/// Colormap at the moment of publication (Colormap_None if raw values are uploaded).
+		ColormapType colormap;
+
+		/// Snapshot of samples.
+		std::vector<std::vector<eT> > samples;
+
+		/// Min values of samples.
+		std::vector<eT> sample_min;
+
+		/// Max values of samples.
+		std::vector<eT> sample_max;
+
+		/// Colours of samples.
+		std::vector<uint32_t> rgba;
+	};
+
+	/*!
+	 * Takes snapshot of the published batch and submits it to the pipeline (GL thread, inside of the critical section).
+	 * @param rows_ Number of rows of a sample.
+	 * @param cols_ Number of columns of a sample.
+	 * @param colormapped_ If set, samples will be coloured with the colormap, otherwise raw values will be uploaded.
+	 */
+	void submitFrame(size_t rows_, size_t cols_, bool colormapped_) {
+		std::shared_ptr<Frame> frame = std::make_shared<Frame>();
+		frame->rows = rows_;
+		frame->cols = cols_;
+		frame->colormap = colormapped_ ? colormap.getType() : Colormap_None;
+		frame->samples.resize(batch_data.size());
+		for (size_t i=0; i < batch_data.size(); i++) {
+			const eT* data_ptr = batch_data[i]->data();
+			// Samples of different size remain empty (black).
+			if (((size_t)batch_data[i]->rows() == rows_) && ((size_t)batch_data[i]->cols() == cols_))
+				frame->samples[i].assign(data_ptr, data_ptr + rows_ * cols_);
+			else
+				frame->samples[i].assign(rows_ * cols_, 0);
+		}//: for
+		pipeline.submit(frame);
+		batch_published = false;
+	}
+
+	/*!
+	 * Computes min/max values of samples of the frame and colours them with the colormap if required (pipeline thread).
+	 * @param frame_ Frame.
+	 */
+	void prepareFrame(Frame & frame_) {
+		frame_.sample_min.resize(frame_.samples.size());
+		frame_.sample_max.resize(frame_.samples.size());
+		if (frame_.colormap != Colormap_None) {
+			frame_.rgba.resize(frame_.samples.size() * frame_.rows * frame_.cols);
+			// Colormap used by the pipeline - the one used by key handlers could change in the meantime.
+			if (pipeline_colormap.getType() != frame_.colormap)
+				pipeline_colormap.setType(frame_.colormap);
+		}//: if
+
+		// Prepare samples in parallel.
+		VGL_WORKER_POOL->parallelFor(0, frame_.samples.size(), std::max<size_t>(1, WorkerPool::min_elements_per_task / (frame_.rows * frame_.cols)),
+				boost::bind(&WindowGrayscaleBatch<eT>::prepareSamples, this, boost::ref(frame_), _1, _2));
+	}
+
+	/*!
+	 * Computes min/max values of a range of samples and colours them with the colormap (if required).
+	 * Every sample is written to a separate part of the buffers, so ranges can be processed in parallel.
+	 * @param frame_ Frame.
+	 * @param first_ Index of the first sample.
+	 * @param last_ Index of the sample after the last one.
+	 */
+	void prepareSamples(Frame & frame_, size_t first_, size_t last_) {
+		size_t size = frame_.rows * frame_.cols;
+		for (size_t i = first_; i < last_; i++) {
+			const eT* data_ptr = frame_.samples[i].data();
+			findMinMax(data_ptr, size, frame_.sample_min[i], frame_.sample_max[i]);
+			if (frame_.colormap != Colormap_None)
+				pipeline_colormap.apply(data_ptr, size, frame_.sample_min[i], frame_.sample_max[i], &frame_.rgba[i * size]);
+		}//: for
+	}
+
+	/*!
+	 * Uploads samples of the prepared frame to textures (GL thread).
+	 * @param frame_ Prepared frame.
+	 */
+	void uploadFrame(const Frame & frame_) {
+		size_t size = frame_.rows * frame_.cols;
+		textures.resize(frame_.samples.size());
+		for (size_t i=0; i < frame_.samples.size(); i++) {
+			if (textures[i] == nullptr)
+				textures[i] = std::make_shared<Texture2D>();
+			// Column-major data: texture is rows wide and cols high.
+			if (frame_.colormap != Colormap_None)
+				textures[i]->uploadRGBA(frame_.rows, frame_.cols, &frame_.rgba[i * size]);
+			else
+				textures[i]->uploadLuminance(frame_.rows, frame_.cols, frame_.samples[i].data());
+		}//: for
+		sample_min = frame_.sample_min;
+		sample_max = frame_.sample_max;
+		displayed_colormapped = (frame_.colormap != Colormap_None);
+	}
+
+	/*!
+	 * Draws a single sample using the fixed pipeline - a rectangle per element (used when shaders are not available).
+	 * @param data_ptr_ Pointer to data.
+	 * @param rows_ Number of rows of the sample.
+	 * @param cols_ Number of columns of the sample.
+	 * @param bx_ Column of the sample in the batch grid.
+	 * @param by_ Row of the sample in the batch grid.
+	 * @param scale_x_ Width of a cell.
+	 * @param scale_y_ Height of a cell.
+	 */
+	void drawSampleImmediate(eT* data_ptr_, size_t rows_, size_t cols_, size_t bx_, size_t by_, eT scale_x_, eT scale_y_) {
+		// Calculate mins and max - for visualization.
+		eT min, max;
+		findMinMax(data_ptr_, rows_*cols_, min, max);
+		// Check whether we can normalize.
+		eT diff = max - min;
+		if (diff == 0.0f) {
+			min = max = 0.0;
+			diff = 1.0f;
+		}
+
+	   	// Iterate through matrix elements.
+		for (size_t y = 0; y < rows_; y++) {
+			for (size_t x = 0; x < cols_; x++) {
+				// Get value - REVERSED! as Eigen::Matrix by default is column-major!!
+				eT val = data_ptr_[x*rows_ + y];
+				eT red, green, blue, alpha;
+
+				// Color depending on the visualization.
+				colorize(normalization, val, min, max, diff, red, green, blue, alpha);
+
+				// Draw rectangle - (x, y, height, width, color)!!
+				draw_filled_rectangle(eT(bx_*cols_+x) * scale_x_, eT(by_*rows_+y) * scale_y_, scale_y_, scale_x_,
+						red, green, blue, alpha);
+
+			}//: for
+		}//: for
+	}
+
 	/*!
 	 * Pointer to displayed batch.
 	 */
@@ -335,6 +443,33 @@ private:
 
 	/// Flag determining whether or what kind of grid to draw.
 	Grid grid;
+
+	/// Shader colouring raw values according to the normalization mode.
+	NormalizationShader shader;
+
+	/// Colormap applied to samples (if other than Colormap_None).
+	Colormap colormap;
+
+	/// Textures storing raw values (or colours) of displayed samples.
+	std::vector<std::shared_ptr<Texture2D> > textures;
+
+	/// Colormap used by the pipeline thread.
+	Colormap pipeline_colormap;
+
+	/// Min values of displayed samples.
+	std::vector<eT> sample_min;
+
+	/// Max values of displayed samples.
+	std::vector<eT> sample_max;
+
+	/// Flag indicating that textures store colours (otherwise they store raw values).
+	bool displayed_colormapped;
+
+	/// Flag indicating that a new batch was published and must be submitted to the pipeline.
+	bool batch_published;
+
+	/// Pipeline preparing textures in the background (declared last, so its thread stops before other members are destroyed).
+	FramePipeline<Frame> pipeline;
 };
 
 } /* namespace visualization */
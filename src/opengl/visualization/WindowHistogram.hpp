@@ -0,0 +1,404 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file WindowHistogram.hpp
+ * \brief Window displaying histogram of values of a matrix or tensor (e.g. weights or gradients), along with its history.
+ * \author tkornuta
+ * \date Oct 18, 2026
+ */
+
+#ifndef SRC_OPENGL_VISUALIZATION_WINDOWHISTOGRAM_HPP_
+#define SRC_OPENGL_VISUALIZATION_WINDOWHISTOGRAM_HPP_
+
+#include <opengl/visualization/Window.hpp>
+#include <opengl/visualization/WindowManager.hpp>
+#include <opengl/visualization/Colormap.hpp>
+#include <opengl/visualization/Histogram.hpp>
+#include <opengl/visualization/Texture2D.hpp>
+
+// Dependencies on core types.
+#include <types/MatrixTypes.hpp>
+#include <types/TensorTypes.hpp>
+
+#include <algorithm>
+#include <sstream>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace mic {
+namespace opengl {
+namespace visualization {
+
+/*!
+ * \brief OpenGL-based window displaying histogram of values of a matrix or tensor.
+ *
+ * Values are binned on publication in parallel (see Histogram).
+ * Bin edges are either fixed or adapted to the range of the finite values (values outside of the fixed range are counted in the border bins).
+ * Non-finite values (NaN, inf) are not binned - they are only counted and their number is displayed.
+ * Bars are drawn with a single call. Under the bars, history of the recent histograms is displayed as a heat strip (the newest at the top), fading out with age.
+ * \author tkornuta
+ * \tparam eT Precision (float/double) (DEFAULT=float).
+ */
+template <typename eT = float>
+class WindowHistogram: public Window {
+public:
+	/*!
+	 * Constructor.
+	 * @param bins_ Number of bins.
+	 * @param history_ Number of histograms displayed in the heat strip.
+	 */
+	WindowHistogram(std::string name_ = "WindowHistogram",
+			unsigned int position_x_ = 0, unsigned int position_y_ = 0,
+			unsigned int width_ = 512, unsigned int height_ = 512,
+			size_t bins_ = 64, size_t history_ = 128) :
+		Window(name_, position_x_, position_y_, width_, height_),
+		bins(std::max<size_t>(1, bins_)),
+		history_size(std::max<size_t>(1, history_)),
+		adaptive_edges(true),
+		fixed_min(-1), fixed_max(1),
+		histogram(bins),
+		history_decay(0.97f),
+		history_head(0), history_length(0),
+		strip_colormap(Colormap_Viridis),
+		data_published(false)
+	{
+		// NULL pointers.
+		matrix_ptr = nullptr;
+		tensor_ptr = nullptr;
+
+		history.assign(history_size * bins, 0.0f);
+
+		// Register additional key handler.
+		REGISTER_KEY_HANDLER('e', "e - toggles adaptive/fixed bin edges", &WindowHistogram<eT>::keyhandlerToggleBinEdges);
+	}
+
+	/*!
+	 * Virtual destructor - empty.
+	 */
+	virtual ~WindowHistogram() { }
+
+	/*!
+	 * Toggles between adaptive and fixed bin edges.
+	 */
+	void keyhandlerToggleBinEdges(void) {
+		// Enter critical section.
+		APP_DATA_SYNCHRONIZATION_SCOPED_LOCK();
+		adaptive_edges = !adaptive_edges;
+		// Histogram must be recomputed.
+		data_published = true;
+		if (adaptive_edges)
+			LOG(LINFO) << "Adapt bin edges to the range of values";
+		else
+			LOG(LINFO) << "Use fixed bin edges <" << fixed_min << "," << fixed_max << ">";
+		// End of critical section.
+	}
+
+	/*!
+	 * Sets fixed bin edges (and switches to them).
+	 * @param min_ Lower edge of the first bin.
+	 * @param max_ Upper edge of the last bin.
+	 */
+	void setFixedBinEdges(eT min_, eT max_) {
+		// Enter critical section.
+		APP_DATA_SYNCHRONIZATION_SCOPED_LOCK();
+		fixed_min = min_;
+		fixed_max = max_;
+		adaptive_edges = false;
+		data_published = true;
+		// End of critical section.
+	}
+
+	/*!
+	 * Switches to bin edges adapted to the range of values.
+	 */
+	void setAdaptiveBinEdges() {
+		// Enter critical section.
+		APP_DATA_SYNCHRONIZATION_SCOPED_LOCK();
+		adaptive_edges = true;
+		data_published = true;
+		// End of critical section.
+	}
+
+	/*!
+	 * Sets decay of the history - histogram of age n is displayed with intensity decay^n.
+	 * @param decay_ Decay (0-1).
+	 */
+	void setHistoryDecay(float decay_) {
+		// Enter critical section.
+		APP_DATA_SYNCHRONIZATION_SCOPED_LOCK();
+		history_decay = decay_;
+		// End of critical section.
+	}
+
+	/*!
+	 * Refreshes the content of the window.
+	 */
+	void displayHandler(void){
+		LOG(LTRACE) << "WindowHistogram::Display handler of window " << glutGetWindow();
+		// Enter critical section.
+		APP_DATA_SYNCHRONIZATION_SCOPED_LOCK();
+
+		// Clear buffer.
+		glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+		// Bin the published data.
+		if (data_published) {
+			computeHistogram();
+			pushHistory();
+			data_published = false;
+		}//: if
+
+		// Layout: bars, labels of edges and heat strip.
+		float bars_height = (float)viewport_height * 0.65f;
+		float labels_y = (float)viewport_height * 0.70f;
+		float strip_y = (float)viewport_height * 0.72f;
+
+		// Draw chart boundary.
+		glLineWidth(1.0f);
+		draw_rectangle(1.0f, 1.0f, bars_height, (float)viewport_width-2.0f, 0.7f, 0.7f, 0.7f, 1.0f);
+
+		drawBars(bars_height);
+
+		draw_text(2.0f, labels_y, const_cast<char*>(min_label.c_str()), 1.0f, 1.0f, 1.0f, 1.0f, GLUT_BITMAP_HELVETICA_10);
+		draw_text((float)viewport_width - 6.0f * (float)max_label.size() - 4.0f, labels_y, const_cast<char*>(max_label.c_str()), 1.0f, 1.0f, 1.0f, 1.0f, GLUT_BITMAP_HELVETICA_10);
+		if (histogram.getNonFiniteCount() > 0)
+			draw_text(0.5f * ((float)viewport_width - 6.0f * (float)non_finite_label.size()), labels_y, const_cast<char*>(non_finite_label.c_str()), 1.0f, 0.5f, 0.5f, 1.0f, GLUT_BITMAP_HELVETICA_10);
+
+		// Draw history.
+		if (strip_texture.isAllocated()) {
+			glEnable(GL_TEXTURE_2D);
+			glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_REPLACE);
+			strip_texture.bind();
+			strip_texture.draw(0.0f, strip_y, (float)viewport_height - strip_y, (float)viewport_width);
+			strip_texture.unbind();
+			glDisable(GL_TEXTURE_2D);
+		}//: if
+
+		// Swap buffers.
+		glutSwapBuffers();
+
+		// End of critical section.
+	}
+
+	/*!
+	 * Sets displayed matrix.
+	 * @param matrix_ptr_ Pointer to the matrix.
+	 */
+	void setDataPointerSynchronized(mic::types::MatrixPtr<eT> matrix_ptr_) {
+		// Enter critical section.
+		APP_DATA_SYNCHRONIZATION_SCOPED_LOCK();
+		setDataPointerUnsynchronized(matrix_ptr_);
+		// End of critical section.
+	}
+
+	/*!
+	 * Sets displayed matrix. Unsynchronized i.e. must be used inside of manually synchronized section.
+	 * @param matrix_ptr_ Pointer to the matrix.
+	 */
+	void setDataPointerUnsynchronized(mic::types::MatrixPtr<eT> matrix_ptr_) {
+		matrix_ptr = matrix_ptr_;
+		tensor_ptr = nullptr;
+		data_published = true;
+	}
+
+	/*!
+	 * Sets displayed tensor.
+	 * @param tensor_ptr_ Pointer to the tensor.
+	 */
+	void setDataPointerSynchronized(mic::types::TensorPtr<eT> tensor_ptr_) {
+		// Enter critical section.
+		APP_DATA_SYNCHRONIZATION_SCOPED_LOCK();
+		setDataPointerUnsynchronized(tensor_ptr_);
+		// End of critical section.
+	}
+
+	/*!
+	 * Sets displayed tensor. Unsynchronized i.e. must be used inside of manually synchronized section.
+	 * @param tensor_ptr_ Pointer to the tensor.
+	 */
+	void setDataPointerUnsynchronized(mic::types::TensorPtr<eT> tensor_ptr_) {
+		tensor_ptr = tensor_ptr_;
+		matrix_ptr = nullptr;
+		data_published = true;
+	}
+
+private:
+
+	/*!
+	 * Returns pointer to the displayed data.
+	 * @param size_ Returned number of elements.
+	 */
+	const eT* getData(size_t & size_) {
+		if (matrix_ptr != nullptr) {
+			size_ = matrix_ptr->size();
+			return matrix_ptr->data();
+		} else if (tensor_ptr != nullptr) {
+			size_ = tensor_ptr->size();
+			return tensor_ptr->data();
+		}//: else
+		size_ = 0;
+		return nullptr;
+	}
+
+	/*!
+	 * Computes edges and counts of bins of the displayed data.
+	 */
+	void computeHistogram() {
+		size_t size;
+		const eT* data = getData(size);
+		if (adaptive_edges)
+			histogram.compute(data, size);
+		else
+			histogram.compute(data, size, fixed_min, fixed_max);
+		if (size == 0)
+			return;
+
+		// Update labels.
+		std::ostringstream min_stream, max_stream, non_finite_stream;
+		min_stream << histogram.getMin();
+		max_stream << histogram.getMax();
+		non_finite_stream << histogram.getNonFiniteCount() << " non-finite";
+		min_label = min_stream.str();
+		max_label = max_stream.str();
+		non_finite_label = non_finite_stream.str();
+	}
+
+	/*!
+	 * Adds the current histogram to the history and recomputes the heat strip.
+	 */
+	void pushHistory() {
+		const std::vector<size_t> & counts = histogram.getCounts();
+		size_t max_count = std::max<size_t>(1, *std::max_element(counts.begin(), counts.end()));
+		for (size_t b = 0; b < bins; b++)
+			history[history_head * bins + b] = (float)counts[b] / (float)max_count;
+		history_length = std::min(history_length + 1, history_size);
+
+		// Newest histogram in the first row, older ones fade out.
+		strip.assign(history_size * bins, 0.0f);
+		float weight = 1.0f;
+		for (size_t age = 0; age < history_length; age++) {
+			const float* row = &history[((history_head + history_size - age) % history_size) * bins];
+			for (size_t b = 0; b < bins; b++)
+				strip[age * bins + b] = row[b] * weight;
+			weight *= history_decay;
+		}//: for
+		history_head = (history_head + 1) % history_size;
+
+		strip_rgba.resize(strip.size());
+		strip_colormap.apply(strip.data(), strip.size(), 0.0f, 1.0f, strip_rgba.data());
+		strip_texture.uploadRGBA(bins, history_size, strip_rgba.data());
+	}
+
+	/*!
+	 * Draws bars of the histogram with a single call.
+	 * @param height_ Height of the chart.
+	 */
+	void drawBars(float height_) {
+		const std::vector<size_t> & counts = histogram.getCounts();
+		size_t max_count = *std::max_element(counts.begin(), counts.end());
+		if (max_count == 0)
+			return;
+		float bin_width = (float)viewport_width / (float)bins;
+		float scale_y = (height_ - 2.0f) / (float)max_count;
+
+		bar_vertices.clear();
+		for (size_t b = 0; b < bins; b++) {
+			if (counts[b] == 0)
+				continue;
+			float x0 = (float)b * bin_width;
+			float x1 = x0 + std::max(1.0f, 0.9f * bin_width);
+			float y = height_ - (float)counts[b] * scale_y;
+			bar_vertices.insert(bar_vertices.end(), {x0, height_, x1, height_, x1, y, x0, y});
+		}//: for
+
+		glColor4f(0.5f, 0.7f, 1.0f, 1.0f);
+		glEnableClientState(GL_VERTEX_ARRAY);
+		glVertexPointer(2, GL_FLOAT, 0, bar_vertices.data());
+		glDrawArrays(GL_QUADS, 0, (GLsizei) (bar_vertices.size() / 2));
+		glDisableClientState(GL_VERTEX_ARRAY);
+	}
+
+	/// Pointer to displayed matrix.
+	mic::types::MatrixPtr<eT> matrix_ptr;
+
+	/// Pointer to displayed tensor.
+	mic::types::TensorPtr<eT> tensor_ptr;
+
+	/// Number of bins.
+	size_t bins;
+
+	/// Number of histograms in the history.
+	size_t history_size;
+
+	/// Flag indicating whether bin edges are adapted to the range of values.
+	bool adaptive_edges;
+
+	/// Lower edge of the first bin (fixed edges).
+	eT fixed_min;
+
+	/// Upper edge of the last bin (fixed edges).
+	eT fixed_max;
+
+	/// Histogram of the displayed data.
+	Histogram<eT> histogram;
+
+	/// History of normalized histograms (ring buffer).
+	std::vector<float> history;
+
+	/// Decay of intensity of older histograms.
+	float history_decay;
+
+	/// Row of the history the next histogram will be stored in.
+	size_t history_head;
+
+	/// Number of histograms stored in the history.
+	size_t history_length;
+
+	/// Heat strip (history ordered by age, with decay applied).
+	std::vector<float> strip;
+
+	/// Colours of the heat strip.
+	std::vector<uint32_t> strip_rgba;
+
+	/// Colormap of the heat strip.
+	Colormap strip_colormap;
+
+	/// Texture storing the heat strip.
+	Texture2D strip_texture;
+
+	/// Vertices of bars (reused between frames).
+	std::vector<float> bar_vertices;
+
+	/// Label of the lower edge.
+	std::string min_label;
+
+	/// Label of the upper edge.
+	std::string max_label;
+
+	/// Label with the number of non-finite values.
+	std::string non_finite_label;
+
+	/// Flag indicating that new data was published and must be binned.
+	bool data_published;
+};
+
+} /* namespace visualization */
+} /* namespace opengl */
+} /* namespace mic */
+
+#endif /* SRC_OPENGL_VISUALIZATION_WINDOWHISTOGRAM_HPP_ */
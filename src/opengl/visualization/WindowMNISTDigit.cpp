@@ -58,8 +58,8 @@ void WindowMNISTDigit::displayHandler(void){
 		size_t w_tensor = displayed_digit->dim(0);
 		size_t h_tensor = displayed_digit->dim(1);
 		//size_t d_tensor = displayed_digit->dim(2);
-		size_t w_window = glutGet(GLUT_WINDOW_WIDTH);
-		size_t h_window = glutGet(GLUT_WINDOW_HEIGHT);
+		size_t w_window = viewport_width;
+		size_t h_window = viewport_height;
 
 		// Compute scales.
 		float w_scale = (float) w_window / w_tensor;
@@ -151,6 +151,10 @@ void WindowMNISTDigit::displayHandler(void){
 			glEnd();
 
 		}//: if !null
+
+		// Draw trajectories of multiple agents.
+		trajectories.synchronizePaths();
+		trajectories.draw(w_scale, h_scale, 2.0f);
 	}//: if !null
 
 
@@ -176,6 +180,14 @@ void WindowMNISTDigit::setPathPointer(std::shared_ptr<std::vector <mic::types::P
 	// End of critical section.
 }
 
+void WindowMNISTDigit::setPathPointers(const std::vector<std::shared_ptr<std::vector <mic::types::Position2D> > > & agent_paths_) {
+	// Enter critical section.
+	APP_DATA_SYNCHRONIZATION_SCOPED_LOCK();
+
+	trajectories.setPaths(agent_paths_);
+	// End of critical section.
+}
+
 } /* namespace visualization */
 } /* namespace opengl */
 } /* namespace mic */
@@ -24,6 +24,7 @@
 #define SRC_OPENGL_VISUALIZATION_WINDOWMNISTDIGIT_HPP_
 
 #include <opengl/visualization/Window.hpp>
+#include <opengl/visualization/TrajectoryBuffer.hpp>
 
 // Dependencies on core types.
 #include <types/TensorTypes.hpp>
@@ -81,6 +82,13 @@ public:
 	 */
 	void setPathPointer(std::shared_ptr<std::vector <mic::types::Position2D> > saccadic_path_);
 
+	/*!
+	 * Sets pointers to paths of multiple agents (e.g. hundreds of concurrently acting agents), each drawn in its own colour.
+	 * Paths are expected to grow - only the new positions are uploaded during refresh. Trajectory of an agent is rebuilt when its path gets shorter or is replaced by another one.
+	 * @param agent_paths_ Vector of paths (a path is a sequence of consecutive agent positions).
+	 */
+	void setPathPointers(const std::vector<std::shared_ptr<std::vector <mic::types::Position2D> > > & agent_paths_);
+
 private:
 
 	/*!
@@ -91,6 +99,9 @@ private:
 	/// Saccadic path to be displayed - a sequence of consecutive agent positions.
 	std::shared_ptr<std::vector <mic::types::Position2D> > saccadic_path;
 
+	/// Trajectories of multiple agents, stored in a single vertex buffer object.
+	TrajectoryBuffer trajectories;
+
 };
 
 } /* namespace visualization */
@@ -103,6 +103,22 @@ namespace mic {
         }//: if
       }
 
+      void WindowManager::motionHandler(int x, int y) {
+        LOG(LTRACE) << "Motion handler of " << glutGetWindow() << " window";
+        Window* w = VGL_MANAGER->findWindow(glutGetWindow());
+        if (w != NULL) {
+          w->motionHandler(x, y);
+        }//: if
+      }
+
+      void WindowManager::passiveMotionHandler(int x, int y) {
+        LOG(LTRACE) << "Passive motion handler of " << glutGetWindow() << " window";
+        Window* w = VGL_MANAGER->findWindow(glutGetWindow());
+        if (w != NULL) {
+          w->passiveMotionHandler(x, y);
+        }//: if
+      }
+
       void WindowManager::reshapeHandler(int width_, int height_) {
         LOG(LTRACE) << "Reshape handler of " << glutGetWindow() << " window";
         Window* w = VGL_MANAGER->findWindow(glutGetWindow());
@@ -90,6 +90,20 @@ namespace mic {
          */
         static void mouseHandler(int button, int state, int x, int y);
 
+        /*!
+         * Handles motion of the mouse with a pressed button.
+         * @param x X coordinate of the mouse pointer.
+         * @param y Y coordinate of the mouse pointer.
+         */
+        static void motionHandler(int x, int y);
+
+        /*!
+         * Handles motion of the mouse without pressed buttons.
+         * @param x X coordinate of the mouse pointer.
+         * @param y Y coordinate of the mouse pointer.
+         */
+        static void passiveMotionHandler(int x, int y);
+
         /*!
          * Changes size of the window.
          * @param width_ New width.
@@ -23,17 +23,40 @@
 #include <opengl/visualization/WindowMatrix2D.hpp>
 #include <opengl/visualization/WindowManager.hpp>
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
 namespace mic {
 namespace opengl {
 namespace visualization {
 
+// Static members.
+const size_t WindowMatrix2D::tile_size;
+const size_t WindowMatrix2D::max_tile_uploads_per_frame;
+const float WindowMatrix2D::zoom_step = 1.25f;
+
 WindowMatrix2D::WindowMatrix2D(std::string name_,
 		unsigned int position_x_, unsigned int position_y_,
 		unsigned int width_ , unsigned int height_) :
-	Window(name_, position_x_, position_y_, width_, height_)
+	Window(name_, position_x_, position_y_, width_, height_),
+	normalization(Norm_None),
+	reduction(Reduction_MaxAbs),
+	refinement_budget(8.0),
+	matrix_min(0.0f), matrix_max(0.0f),
+	matrix_published(false),
+	texture_outdated(false),
+	view_zoom(1.0f), view_row(0.0f), view_col(0.0f),
+	dragging(false), drag_x(0), drag_y(0)
 {
 	// NULL pointer.
 	displayed_matrix_ptr = nullptr;
+
+	// Register additional key handler.
+	REGISTER_KEY_HANDLER('n', "n - toggles normalization mode", &WindowMatrix2D::keyhandlerToggleNormalizationMode);
+	REGISTER_KEY_HANDLER('m', "m - toggles colormap", &WindowMatrix2D::keyhandlerToggleColormap);
+	REGISTER_KEY_HANDLER('r', "r - toggles reduction of large matrices", &WindowMatrix2D::keyhandlerToggleReduction);
+	REGISTER_KEY_HANDLER('z', "z - resets zoom", &WindowMatrix2D::keyhandlerResetView);
 }
 
 
@@ -51,34 +74,51 @@ void WindowMatrix2D::displayHandler(void){
 	glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
 	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
+	// Rebuild pyramid of the published matrix.
+	if ((displayed_matrix_ptr != nullptr) && matrix_published)
+		resetPyramid();
+
 	// Draw matrix 2d.
-	if (displayed_matrix_ptr != nullptr){
-		// Set temporal variables.
-		size_t rows = displayed_matrix_ptr->rows();
-		size_t cols = displayed_matrix_ptr->cols();
-    	float* data_ptr = displayed_matrix_ptr->data();
-
-		// Compute scale.
-    	float scale_x = (float)glutGet(GLUT_WINDOW_HEIGHT)/(float)(rows);
-    	float scale_y = (float)glutGet(GLUT_WINDOW_WIDTH)/(float)(cols);
-
-    	// Iterate through matrix elements.
-		for (size_t y = 0; y < rows; y++) {
-			for (size_t x = 0; x < cols; x++) {
-				// Get value - REVERSED! as Eigen::Matrix by default is column-major!!
-				float val = data_ptr[x*rows + y];
-
-				// Draw rectangle.
-		        draw_filled_rectangle(float(x) * scale_y, float(y) * scale_x, scale_x, scale_y,
-		        (float)val,
-		        (float)val,
-		        (float)val,
-		        (float)1.0f);
+	if ((displayed_matrix_ptr != nullptr) && (pyramid.getLevels() > 0)){
+		// Refine the pyramid within the time budget, so the window stays responsive regardless of the size of the matrix.
+		if ((!pyramid.isComplete()) && pyramid.refine(refinement_budget))
+			// Exact min/max values are known - tiles coloured using the estimated ones must be uploaded again.
+			texture_outdated = true;
+		matrix_min = pyramid.getMin();
+		matrix_max = pyramid.getMax();
 
-			}//: for
-		}//: for
+		// Select level with (roughly) one visible element per pixel - tiles are not limited by the max size of a texture.
+		size_t level = pyramid.selectLevel((size_t)(viewport_width * view_zoom), (size_t)(viewport_height * view_zoom), std::numeric_limits<size_t>::max());
+
+		bool colormapped = (colormap.getType() != Colormap_None);
+		if (colormapped || shader.build()) {
+			if (texture_outdated) {
+				tile_cache.clear();
+				texture_outdated = false;
+			}//: if
 
-		draw_grid(0.5f, 0.3f, 0.3f, 0.3f, cols, rows);
+			if (colormapped) {
+				// Tiles already store colours.
+				glEnable(GL_TEXTURE_2D);
+				glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_REPLACE);
+			} else
+				// Colour on the GPU - normalization is just a uniform.
+				shader.useGrayscale(normalization, matrix_min, matrix_max);
+
+			drawTiles(level, colormapped);
+
+			if (colormapped)
+				glDisable(GL_TEXTURE_2D);
+			else
+				shader.release();
+		} else {
+			// Draw the finest level that is already built.
+			while (!pyramid.isAvailable(level, pyramid.getCols(level)))
+				level++;
+			drawLevelImmediate(level);
+		}//: else
+
+		drawElementGrid(level);
 	}//: if !null
 
 	// Swap buffers.
@@ -88,6 +128,322 @@ void WindowMatrix2D::displayHandler(void){
 }
 
 
+void WindowMatrix2D::mouseHandler(int button, int state, int x, int y) {
+	// Enter critical section.
+	APP_DATA_SYNCHRONIZATION_SCOPED_LOCK();
+	// Wheel is reported as buttons 3 (up) and 4 (down).
+	if ((button == 3) && (state == GLUT_DOWN))
+		zoomAt(x, y, zoom_step);
+	else if ((button == 4) && (state == GLUT_DOWN))
+		zoomAt(x, y, 1.0f / zoom_step);
+	else if (button == GLUT_LEFT_BUTTON) {
+		dragging = (state == GLUT_DOWN);
+		drag_x = x;
+		drag_y = y;
+	}//: else
+	// End of critical section.
+}
+
+
+void WindowMatrix2D::motionHandler(int x, int y) {
+	// Enter critical section.
+	APP_DATA_SYNCHRONIZATION_SCOPED_LOCK();
+	if (dragging && (pyramid.getLevels() > 0) && (viewport_width > 0) && (viewport_height > 0)) {
+		// Move the view by the number of elements the pointer moved over.
+		view_col -= (float)(x - drag_x) * (float)pyramid.getCols(0) / (view_zoom * (float)viewport_width);
+		view_row -= (float)(y - drag_y) * (float)pyramid.getRows(0) / (view_zoom * (float)viewport_height);
+		clampView();
+	}//: if
+	drag_x = x;
+	drag_y = y;
+	// End of critical section.
+}
+
+
+void WindowMatrix2D::keyhandlerToggleNormalizationMode(void) {
+	// Enter critical section.
+	APP_DATA_SYNCHRONIZATION_SCOPED_LOCK();
+	normalization = (Normalization)((normalization + 1) % 4);
+	LOG(LINFO) << norm2str(normalization);
+	// End of critical section.
+}
+
+
+void WindowMatrix2D::keyhandlerToggleColormap(void) {
+	// Enter critical section.
+	APP_DATA_SYNCHRONIZATION_SCOPED_LOCK();
+	colormap.setType((ColormapType)((colormap.getType() + 1) % Colormap_Count));
+	// Tiles must be recoloured.
+	texture_outdated = true;
+	LOG(LINFO) << Colormap::colormap2str(colormap.getType());
+	// End of critical section.
+}
+
+
+void WindowMatrix2D::keyhandlerToggleReduction(void) {
+	// Enter critical section.
+	APP_DATA_SYNCHRONIZATION_SCOPED_LOCK();
+	reduction = (PyramidReduction)((reduction + 1) % Reduction_Count);
+	// Pyramid must be rebuilt.
+	matrix_published = true;
+	LOG(LINFO) << MatrixPyramid::reduction2str(reduction);
+	// End of critical section.
+}
+
+
+void WindowMatrix2D::keyhandlerResetView(void) {
+	// Enter critical section.
+	APP_DATA_SYNCHRONIZATION_SCOPED_LOCK();
+	view_zoom = 1.0f;
+	view_row = view_col = 0.0f;
+	// End of critical section.
+}
+
+
+void WindowMatrix2D::setTileCacheBudget(size_t budget_) {
+	// Enter critical section.
+	APP_DATA_SYNCHRONIZATION_SCOPED_LOCK();
+	tile_cache.setBudget(budget_);
+	// End of critical section.
+}
+
+
+void WindowMatrix2D::setRefinementBudget(double budget_) {
+	// Enter critical section.
+	APP_DATA_SYNCHRONIZATION_SCOPED_LOCK();
+	refinement_budget = budget_;
+	// End of critical section.
+}
+
+
+void WindowMatrix2D::resetPyramid() {
+	// Preview fits into a single tile.
+	pyramid.reset(displayed_matrix_ptr, reduction, tile_size);
+	matrix_published = false;
+	texture_outdated = true;
+	// Size of the matrix could change.
+	clampView();
+}
+
+
+void WindowMatrix2D::visibleRange(size_t level_, size_t & row_begin_, size_t & row_end_, size_t & col_begin_, size_t & col_end_) {
+	// Number of elements of the matrix covered by a single element of the level.
+	float scale = (float)((size_t)1 << level_);
+	float view_rows = (float)pyramid.getRows(0) / view_zoom;
+	float view_cols = (float)pyramid.getCols(0) / view_zoom;
+	row_begin_ = (size_t)std::floor(view_row / scale);
+	row_end_ = std::min(pyramid.getRows(level_), (size_t)std::ceil((view_row + view_rows) / scale));
+	col_begin_ = (size_t)std::floor(view_col / scale);
+	col_end_ = std::min(pyramid.getCols(level_), (size_t)std::ceil((view_col + view_cols) / scale));
+}
+
+
+void WindowMatrix2D::drawTiles(size_t level_, bool colormapped_) {
+	tile_cache.nextFrame();
+	size_t uploads = 0;
+
+	// Find the coarsest level fitting into a single tile - drawn under all other tiles, so there is always something to display.
+	size_t overview = level_;
+	while ((overview + 1 < pyramid.getLevels()) && ((pyramid.getRows(overview) > tile_size) || (pyramid.getCols(overview) > tile_size)))
+		overview++;
+	if (overview != level_) {
+		Texture2D* texture = tile_cache.find(overview, 0, 0);
+		if (texture == nullptr) {
+			texture = uploadTile(overview, 0, 0, colormapped_);
+			uploads++;
+		}//: if
+		if (texture != nullptr)
+			drawTileRegion(*texture, overview, 0, 0, 0.0f, (float)pyramid.getRows(overview), 0.0f, (float)pyramid.getCols(overview));
+	}//: if
+
+	// Draw visible tiles of the selected level.
+	size_t row_begin, row_end, col_begin, col_end;
+	visibleRange(level_, row_begin, row_end, col_begin, col_end);
+	for (size_t ty = row_begin / tile_size; ty * tile_size < row_end; ty++) {
+		for (size_t tx = col_begin / tile_size; tx * tile_size < col_end; tx++) {
+			// Region of the level covered by the tile.
+			float tile_row_begin = (float)(ty * tile_size);
+			float tile_row_end = (float)std::min((ty + 1) * tile_size, pyramid.getRows(level_));
+			float tile_col_begin = (float)(tx * tile_size);
+			float tile_col_end = (float)std::min((tx + 1) * tile_size, pyramid.getCols(level_));
+
+			Texture2D* texture = tile_cache.find(level_, tx, ty);
+			if ((texture == nullptr) && (uploads < max_tile_uploads_per_frame) && pyramid.isAvailable(level_, (size_t)tile_col_end)) {
+				texture = uploadTile(level_, tx, ty, colormapped_);
+				uploads++;
+			}//: if
+			if (texture != nullptr) {
+				drawTileRegion(*texture, level_, tx, ty, tile_row_begin, tile_row_end, tile_col_begin, tile_col_end);
+				continue;
+			}//: if
+
+			// Tile is not available yet - cover it with the finest cached ancestor (above the overview).
+			for (size_t k = 1; level_ + k < overview; k++) {
+				texture = tile_cache.find(level_ + k, tx >> k, ty >> k);
+				if (texture == nullptr)
+					continue;
+				float scale = (float)((size_t)1 << k);
+				drawTileRegion(*texture, level_ + k, tx >> k, ty >> k,
+						tile_row_begin / scale, tile_row_end / scale, tile_col_begin / scale, tile_col_end / scale);
+				break;
+			}//: for
+		}//: for
+	}//: for
+}
+
+
+Texture2D* WindowMatrix2D::uploadTile(size_t level_, size_t tile_x_, size_t tile_y_, bool colormapped_) {
+	size_t level_rows = pyramid.getRows(level_);
+	size_t row_begin = tile_y_ * tile_size;
+	size_t col_begin = tile_x_ * tile_size;
+	size_t rows = std::min(tile_size, level_rows - row_begin);
+	size_t cols = std::min(tile_size, pyramid.getCols(level_) - col_begin);
+
+	// Both raw values and colours take 4 bytes per element.
+	Texture2D* texture = tile_cache.insert(level_, tile_x_, tile_y_, rows * cols * 4);
+	if (texture == nullptr)
+		return nullptr;
+
+	// Gather the tile - columns of the level are contiguous.
+	const float* data_ptr = pyramid.getData(level_);
+	tile_buffer.resize(rows * cols);
+	for (size_t x = 0; x < cols; x++) {
+		const float* col_ptr = data_ptr + (col_begin + x) * level_rows + row_begin;
+		std::copy(col_ptr, col_ptr + rows, &tile_buffer[x * rows]);
+	}//: for
+
+	// Column-major data: texture is rows wide and cols high.
+	if (colormapped_) {
+		rgba.resize(rows * cols);
+		colormap.apply(tile_buffer.data(), rows * cols, matrix_min, matrix_max, rgba.data());
+		texture->uploadRGBA(rows, cols, rgba.data());
+	} else
+		texture->uploadLuminance(rows, cols, tile_buffer.data());
+	return texture;
+}
+
+
+void WindowMatrix2D::drawTileRegion(Texture2D & texture_, size_t level_, size_t tile_x_, size_t tile_y_, float row_begin_, float row_end_, float col_begin_, float col_end_) {
+	// Size of the element of the level in pixels.
+	float scale = (float)((size_t)1 << level_) * view_zoom;
+	float element_height = scale * (float)viewport_height / (float)pyramid.getRows(0);
+	float element_width = scale * (float)viewport_width / (float)pyramid.getCols(0);
+	float offset_row = view_row / (float)((size_t)1 << level_);
+	float offset_col = view_col / (float)((size_t)1 << level_);
+
+	// Texture stores the column-major tile (rows x cols), hence it is drawn transposed.
+	float s0 = (row_begin_ - (float)(tile_y_ * tile_size)) / (float)texture_.getWidth();
+	float s1 = (row_end_ - (float)(tile_y_ * tile_size)) / (float)texture_.getWidth();
+	float t0 = (col_begin_ - (float)(tile_x_ * tile_size)) / (float)texture_.getHeight();
+	float t1 = (col_end_ - (float)(tile_x_ * tile_size)) / (float)texture_.getHeight();
+
+	texture_.bind();
+	texture_.draw((col_begin_ - offset_col) * element_width, (row_begin_ - offset_row) * element_height,
+			(row_end_ - row_begin_) * element_height, (col_end_ - col_begin_) * element_width,
+			s0, t0, std::min(s1, 1.0f), std::min(t1, 1.0f), true);
+	texture_.unbind();
+}
+
+
+void WindowMatrix2D::drawElementGrid(size_t level_) {
+	// Grid is visible only if elements are not reduced.
+	if (level_ != 0)
+		return;
+	float element_height = view_zoom * (float)viewport_height / (float)pyramid.getRows(0);
+	float element_width = view_zoom * (float)viewport_width / (float)pyramid.getCols(0);
+	// Do not cover small elements with lines.
+	if ((element_height < 2.0f) || (element_width < 2.0f))
+		return;
+
+	size_t row_begin, row_end, col_begin, col_end;
+	visibleRange(0, row_begin, row_end, col_begin, col_end);
+	std::vector<float> vertices;
+	for (size_t y = row_begin + 1; y < row_end; y++) {
+		float py = ((float)y - view_row) * element_height;
+		vertices.insert(vertices.end(), {0.0f, py, (float)viewport_width, py});
+	}//: for
+	for (size_t x = col_begin + 1; x < col_end; x++) {
+		float px = ((float)x - view_col) * element_width;
+		vertices.insert(vertices.end(), {px, 0.0f, px, (float)viewport_height});
+	}//: for
+	if (vertices.empty())
+		return;
+
+	glColor4f(0.5f, 0.3f, 0.3f, 0.3f);
+	glLineWidth(1.0f);
+	glEnableClientState(GL_VERTEX_ARRAY);
+	glVertexPointer(2, GL_FLOAT, 0, vertices.data());
+	glDrawArrays(GL_LINES, 0, (GLsizei) (vertices.size() / 2));
+	glDisableClientState(GL_VERTEX_ARRAY);
+}
+
+
+void WindowMatrix2D::zoomAt(int x, int y, float factor_) {
+	if ((pyramid.getLevels() == 0) || (viewport_width <= 0) || (viewport_height <= 0))
+		return;
+	float rows = (float)pyramid.getRows(0);
+	float cols = (float)pyramid.getCols(0);
+	// Element under the pointer.
+	float row = view_row + (float)y * rows / (view_zoom * (float)viewport_height);
+	float col = view_col + (float)x * cols / (view_zoom * (float)viewport_width);
+	view_zoom *= factor_;
+	clampView();
+	// Keep it under the pointer.
+	view_row = row - (float)y * rows / (view_zoom * (float)viewport_height);
+	view_col = col - (float)x * cols / (view_zoom * (float)viewport_width);
+	clampView();
+}
+
+
+void WindowMatrix2D::clampView() {
+	if (pyramid.getLevels() == 0)
+		return;
+	float rows = (float)pyramid.getRows(0);
+	float cols = (float)pyramid.getCols(0);
+	// At least a few elements remain visible.
+	view_zoom = std::max(1.0f, std::min(view_zoom, std::max(rows, cols) / 4.0f));
+	view_row = std::max(0.0f, std::min(view_row, rows - rows / view_zoom));
+	view_col = std::max(0.0f, std::min(view_col, cols - cols / view_zoom));
+}
+
+
+void WindowMatrix2D::drawLevelImmediate(size_t level_) {
+	// Set temporal variables.
+	size_t rows = pyramid.getRows(level_);
+	const float* data_ptr = pyramid.getData(level_);
+
+	// Compute size of the element of the level in pixels.
+	float scale = (float)((size_t)1 << level_) * view_zoom;
+	float scale_x = scale * (float)viewport_height / (float)pyramid.getRows(0);
+	float scale_y = scale * (float)viewport_width / (float)pyramid.getCols(0);
+	float offset_row = view_row / (float)((size_t)1 << level_);
+	float offset_col = view_col / (float)((size_t)1 << level_);
+
+	// Check whether we can normalize.
+	float min = matrix_min;
+	float max = matrix_max;
+	float diff = max - min;
+	if (diff == 0.0f) {
+		min = max = 0.0;
+		diff = 1.0f;
+	}
+
+	// Iterate through visible elements.
+	size_t row_begin, row_end, col_begin, col_end;
+	visibleRange(level_, row_begin, row_end, col_begin, col_end);
+	for (size_t y = row_begin; y < row_end; y++) {
+		for (size_t x = col_begin; x < col_end; x++) {
+			// Get value - REVERSED! as Eigen::Matrix by default is column-major!!
+			float val = data_ptr[x*rows + y];
+			float red, green, blue, alpha;
+			colorize(normalization, val, min, max, diff, red, green, blue, alpha);
+
+			// Draw rectangle.
+			draw_filled_rectangle(((float)x - offset_col) * scale_y, ((float)y - offset_row) * scale_x, scale_x, scale_y, red, green, blue, alpha);
+		}//: for
+	}//: for
+}
+
 
 void WindowMatrix2D::setMatrixSynchronized(mic::types::MatrixXf & displayed_matrix_) {
 	// Enter critical section.
@@ -98,6 +454,7 @@ void WindowMatrix2D::setMatrixSynchronized(mic::types::MatrixXf & displayed_matr
 		displayed_matrix_ptr = MAKE_MATRIX_PTR(float, displayed_matrix_);
 	else
 		*displayed_matrix_ptr = displayed_matrix_;
+	matrix_published = true;
 	// End of critical section.
 }
 
@@ -107,6 +464,7 @@ void WindowMatrix2D::setMatrixUnsynchronized(mic::types::MatrixXf & displayed_ma
 		displayed_matrix_ptr = MAKE_MATRIX_PTR(float, displayed_matrix_);
 	else
 		*displayed_matrix_ptr = displayed_matrix_;
+	matrix_published = true;
 }
 
 
@@ -116,11 +474,13 @@ void WindowMatrix2D::setMatrixPointerSynchronized(mic::types::MatrixXfPtr displa
 	APP_DATA_SYNCHRONIZATION_SCOPED_LOCK();
 
 	displayed_matrix_ptr = displayed_matrix_ptr_;
+	matrix_published = true;
 	// End of critical section.
 }
 
 void WindowMatrix2D::setMatrixPointerUnsynchronized(mic::types::MatrixXfPtr displayed_matrix_ptr_) {
 	displayed_matrix_ptr = displayed_matrix_ptr_;
+	matrix_published = true;
 }
 
 
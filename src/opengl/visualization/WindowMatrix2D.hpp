@@ -24,6 +24,12 @@
 #define SRC_VISUALIZATION_OPENGL_WINDOWMATRIX2D_HPP_
 
 #include <opengl/visualization/Window.hpp>
+#include <opengl/visualization/Grayscale.hpp>
+#include <opengl/visualization/Colormap.hpp>
+#include <opengl/visualization/NormalizationShader.hpp>
+#include <opengl/visualization/Texture2D.hpp>
+#include <opengl/visualization/MatrixPyramid.hpp>
+#include <opengl/visualization/TileCache.hpp>
 
 // Dependencies on core types.
 #include <types/MatrixTypes.hpp>
@@ -35,9 +41,14 @@ namespace visualization {
 
 /*!
  * \brief OpenGL-based window responsible for displaying 2D matrices.
+ *
+ * Large matrices are displayed using a level-of-detail pyramid built on publication - the drawn level has (roughly) one element per pixel, so the cost of rendering is bounded by the size of the window, not the matrix.
+ * The view can be zoomed with the mouse wheel and panned by dragging. Levels are split into tiles and only the visible ones are uploaded (a few per frame) to a LRU tile cache;
+ * missing tiles are covered with the coarser ones until they stream in.
+ * The pyramid is built progressively - a preview sampled from the matrix is displayed right after publication and levels are refined during the next frames, within a per-frame time budget.
  * \author tkornuta/krocki
  */
-class WindowMatrix2D: public Window {
+class WindowMatrix2D: public Window, public Grayscale {
 public:
 	/*!
 	 * Constructor. NULLs the image pointer.
@@ -57,6 +68,50 @@ public:
 	 */
 	void displayHandler(void);
 
+	/*!
+	 * Handles mouse buttons - wheel zooms the view, left button starts/stops dragging.
+	 */
+	void mouseHandler(int button, int state, int x, int y);
+
+	/*!
+	 * Pans the view when dragged.
+	 * @param x X coordinate of the mouse pointer.
+	 * @param y Y coordinate of the mouse pointer.
+	 */
+	void motionHandler(int x, int y);
+
+	/*!
+	 * Changes normalization mode.
+	 */
+	void keyhandlerToggleNormalizationMode(void);
+
+	/*!
+	 * Changes colormap.
+	 */
+	void keyhandlerToggleColormap(void);
+
+	/*!
+	 * Changes reduction used for building of the level-of-detail pyramid.
+	 */
+	void keyhandlerToggleReduction(void);
+
+	/*!
+	 * Resets zoom - displays the whole matrix.
+	 */
+	void keyhandlerResetView(void);
+
+	/*!
+	 * Sets GPU memory budget of the tile cache.
+	 * @param budget_ Budget (in bytes).
+	 */
+	void setTileCacheBudget(size_t budget_);
+
+	/*!
+	 * Sets time spent on refinement of the pyramid during a single frame.
+	 * @param budget_ Budget (in milliseconds).
+	 */
+	void setRefinementBudget(double budget_);
+
 	/*!
 	 * Sets displayed matrix.
 	 * @param displayed_matrix_
@@ -84,10 +139,146 @@ public:
 
 private:
 
+	/*!
+	 * Starts building of the level-of-detail pyramid of the published matrix (aborts refinement of the previous one).
+	 */
+	void resetPyramid();
+
+	/*!
+	 * Computes range of elements of a given level visible in the window.
+	 * @param level_ Index of the level.
+	 * @param row_begin_ Returned first visible row.
+	 * @param row_end_ Returned row after the last visible one.
+	 * @param col_begin_ Returned first visible column.
+	 * @param col_end_ Returned column after the last visible one.
+	 */
+	void visibleRange(size_t level_, size_t & row_begin_, size_t & row_end_, size_t & col_begin_, size_t & col_end_);
+
+	/*!
+	 * Draws visible tiles of a given level, uploading the missing ones (a limited number per frame) and covering the rest with coarser tiles.
+	 * @param level_ Index of the level.
+	 * @param colormapped_ If set, tiles are coloured with the colormap, otherwise raw values are uploaded.
+	 */
+	void drawTiles(size_t level_, bool colormapped_);
+
+	/*!
+	 * Uploads a tile of a given level to the tile cache.
+	 * @param level_ Index of the level.
+	 * @param tile_x_ Horizontal index of the tile.
+	 * @param tile_y_ Vertical index of the tile.
+	 * @param colormapped_ If set, tile is coloured with the colormap and uploaded as RGBA, otherwise raw values are uploaded.
+	 * @return Texture of the tile or nullptr if it does not fit into the budget.
+	 */
+	Texture2D* uploadTile(size_t level_, size_t tile_x_, size_t tile_y_, bool colormapped_);
+
+	/*!
+	 * Draws region of a tile (texture must be bound).
+	 * @param texture_ Texture of the tile.
+	 * @param level_ Index of the level.
+	 * @param tile_x_ Horizontal index of the tile.
+	 * @param tile_y_ Vertical index of the tile.
+	 * @param row_begin_ First row of the region (element of the level, can be fractional).
+	 * @param row_end_ Row after the last one.
+	 * @param col_begin_ First column of the region.
+	 * @param col_end_ Column after the last one.
+	 */
+	void drawTileRegion(Texture2D & texture_, size_t level_, size_t tile_x_, size_t tile_y_, float row_begin_, float row_end_, float col_begin_, float col_end_);
+
+	/*!
+	 * Draws grid dividing visible elements (only if they are large enough).
+	 * @param level_ Index of the displayed level.
+	 */
+	void drawElementGrid(size_t level_);
+
+	/*!
+	 * Zooms the view, keeping the element under the mouse pointer in place.
+	 * @param x X coordinate of the mouse pointer.
+	 * @param y Y coordinate of the mouse pointer.
+	 * @param factor_ Zoom factor.
+	 */
+	void zoomAt(int x, int y, float factor_);
+
+	/*!
+	 * Limits zoom and keeps the view inside of the matrix.
+	 */
+	void clampView();
+
+	/*!
+	 * Draws a given level of the pyramid using the fixed pipeline - a rectangle per element (used when shaders are not available).
+	 * @param level_ Index of the level.
+	 */
+	void drawLevelImmediate(size_t level_);
+
 	/*!
 	 * Pointer to displayed matrix.
 	 */
 	mic::types::MatrixXfPtr displayed_matrix_ptr;
+
+	/// Normalization mode.
+	Normalization normalization;
+
+	/// Shader colouring raw values according to the normalization mode.
+	NormalizationShader shader;
+
+	/// Colormap applied to the matrix (if other than Colormap_None).
+	Colormap colormap;
+
+	/// Cache of textures of tiles.
+	TileCache tile_cache;
+
+	/// Buffer storing values of the uploaded tile.
+	std::vector<float> tile_buffer;
+
+	/// Buffer storing colours of the uploaded tile.
+	std::vector<uint32_t> rgba;
+
+	/// Level-of-detail pyramid of the matrix.
+	MatrixPyramid pyramid;
+
+	/// Reduction used for building of the pyramid.
+	PyramidReduction reduction;
+
+	/// Time spent on refinement of the pyramid during a single frame (in milliseconds).
+	double refinement_budget;
+
+	/// Min value of the matrix (estimated until the pyramid is complete).
+	float matrix_min;
+
+	/// Max value of the matrix (estimated until the pyramid is complete).
+	float matrix_max;
+
+	/// Flag indicating that a new matrix was published and the pyramid must be rebuilt.
+	bool matrix_published;
+
+	/// Flag indicating that the tiles must be uploaded again (e.g. when the colormap changes).
+	bool texture_outdated;
+
+	/// Zoom of the view (1 - whole matrix is visible).
+	float view_zoom;
+
+	/// First visible row (of the matrix, can be fractional).
+	float view_row;
+
+	/// First visible column (of the matrix, can be fractional).
+	float view_col;
+
+	/// Flag indicating that the view is being dragged.
+	bool dragging;
+
+	/// X coordinate of the mouse pointer during dragging.
+	int drag_x;
+
+	/// Y coordinate of the mouse pointer during dragging.
+	int drag_y;
+
+	/// Size of tiles (number of rows and columns of a level).
+	static const size_t tile_size = 256;
+
+	/// Max number of tiles uploaded during a single frame - the rest streams in during the next ones.
+	static const size_t max_tile_uploads_per_frame = 4;
+
+	/// Zoom factor of a single step of the mouse wheel.
+	static const float zoom_step;
 };
 
 } /* namespace visualization */
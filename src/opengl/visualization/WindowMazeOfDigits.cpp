@@ -24,6 +24,8 @@
 #include <opengl/visualization/WindowMazeOfDigits.hpp>
 #include <opengl/visualization/WindowManager.hpp>
 
+#include <algorithm>
+
 namespace mic {
 namespace opengl {
 namespace visualization {
@@ -31,15 +33,29 @@ namespace visualization {
 WindowMazeOfDigits::WindowMazeOfDigits(std::string name_,
 		unsigned int position_x_, unsigned int position_y_,
 		unsigned int width_ , unsigned int height_) :
-	Window(name_, position_x_, position_y_, width_, height_)
+	Window(name_, position_x_, position_y_, width_, height_),
+	digit_colormap(Colormap_Categorical),
+	value_policy_version(0),
+	uploaded_version(0),
+	show_values(true),
+	show_policy(true),
+	value_colormap(Colormap_Viridis),
+	arrow_buffer_id(0),
+	arrow_vertex_count(0)
 {
 	// NULL pointer.
 	displayed_maze = nullptr;
+	value_policy = nullptr;
+
+	// Register additional key handler.
+	REGISTER_KEY_HANDLER('v', "v - shows/hides values", &WindowMazeOfDigits::keyhandlerToggleValues);
+	REGISTER_KEY_HANDLER('p', "p - shows/hides policy", &WindowMazeOfDigits::keyhandlerTogglePolicy);
 }
 
 
 WindowMazeOfDigits::~WindowMazeOfDigits() {
-	// TODO Auto-generated destructor stub
+	if (arrow_buffer_id != 0)
+		glDeleteBuffers(1, &arrow_buffer_id);
 }
 
 
@@ -59,8 +75,8 @@ void WindowMazeOfDigits::displayHandler(void){
 		size_t w_tensor = displayed_maze->dim(0);
 		size_t h_tensor = displayed_maze->dim(1);
 		size_t d_tensor = displayed_maze->dim(2);
-		size_t w_window = glutGet(GLUT_WINDOW_WIDTH);
-		size_t h_window = glutGet(GLUT_WINDOW_HEIGHT);
+		size_t w_window = viewport_width;
+		size_t h_window = viewport_height;
 
 		// Compute scales.
 		float w_scale = (float) w_window / w_tensor;
@@ -72,35 +88,17 @@ void WindowMazeOfDigits::displayHandler(void){
 		std::cout<< " w_scale= "<< w_scale << " h_scale= "<< h_scale<< std::endl;*/
 
 
+		// Draw cells.
+		drawCells(w_tensor, h_tensor, w_scale, h_scale);
+
+		// Draw values and policy.
+		drawValuePolicy(w_scale, h_scale);
+
     	// Iterate through maze of digits elements.
 		for (size_t y = 0; y < h_tensor; y++) {
 			for (size_t x = 0; x < w_tensor; x++) {
-
-				// Get value.
 				float r, g, b;
 
-				// Check cell.
-				if ((d_tensor > (size_t)MazeOfDigitsChannels::Walls) && (*displayed_maze)({x,y, (size_t)MazeOfDigitsChannels::Walls})) {
-					r = 0.0; g = 0.0; b = 0.0;
-				} else {
-					unsigned short digit = (*displayed_maze)({x,y, (size_t)MazeOfDigitsChannels::Digits});
-					switch(digit){
-					case 0: r = 0.0; g = 0.0; b = 0.3; break;
-					case 1: r = 0.0; g = 0.0; b = 0.6; break;
-					case 2: r = 0.0; g = 0.0; b = 0.9; break;
-					case 3: r = 0.0; g = 0.3; b = 1.0; break;
-					case 4: r = 0.0; g = 0.6; b = 0.6; break;
-					case 5: r = 0.0; g = 0.9; b = 0.3; break;
-					case 6: r = 1.0; g = 0.75; b = 0.0; break;
-					case 7: r = 1.0; g = 0.5; b = 0.0; break;
-					case 8: r = 1.0; g = 0.25; b = 0.0; break;
-					case 9: r = 1.0; g = 1.0; b = 1.0; break;
-					}
-				}//: else
-
-				// Draw rectangle.
-		        draw_filled_rectangle(float(x) * w_scale, float(y) * h_scale, h_scale, w_scale, r,g, b, (float)1.0f);
-
 		        // Draw goal.
 				if ((d_tensor > (size_t)MazeOfDigitsChannels::Goals) && (*displayed_maze)({x,y, (size_t)MazeOfDigitsChannels::Goals})) {
 					// Draw circle.
@@ -172,6 +170,10 @@ void WindowMazeOfDigits::displayHandler(void){
 
 		}//: if !null
 
+		// Draw trajectories of multiple agents.
+		trajectories.synchronizePaths();
+		trajectories.draw(w_scale, h_scale, 2.0f);
+
 	}//: if !null
 
 	// Swap buffers.
@@ -188,6 +190,172 @@ void WindowMazeOfDigits::setMazePointer(mic::types::TensorXfPtr displayed_maze_)
 	// End of critical section.
 }
 
+void WindowMazeOfDigits::setValuePolicyPointer(mic::types::TensorXfPtr value_policy_) {
+	// Enter critical section.
+	APP_DATA_SYNCHRONIZATION_SCOPED_LOCK();
+
+	value_policy = value_policy_;
+	value_policy_version++;
+	// End of critical section.
+}
+
+void WindowMazeOfDigits::keyhandlerToggleValues(void) {
+	// Enter critical section.
+	APP_DATA_SYNCHRONIZATION_SCOPED_LOCK();
+	show_values = !show_values;
+	// End of critical section.
+}
+
+void WindowMazeOfDigits::keyhandlerTogglePolicy(void) {
+	// Enter critical section.
+	APP_DATA_SYNCHRONIZATION_SCOPED_LOCK();
+	show_policy = !show_policy;
+	// End of critical section.
+}
+
+void WindowMazeOfDigits::drawCells(size_t w_tensor_, size_t h_tensor_, float w_scale_, float h_scale_) {
+	size_t d_tensor = displayed_maze->dim(2);
+	cell_vertices.resize(8 * w_tensor_ * h_tensor_);
+	cell_colors.resize(4 * w_tensor_ * h_tensor_);
+
+	float* vertex = cell_vertices.data();
+	uint32_t* color = cell_colors.data();
+	uint32_t wall_color = Colormap::pack(0.0f, 0.0f, 0.0f);
+	for (size_t y = 0; y < h_tensor_; y++) {
+		for (size_t x = 0; x < w_tensor_; x++) {
+			// Check cell.
+			uint32_t rgba;
+			if ((d_tensor > (size_t)MazeOfDigitsChannels::Walls) && (*displayed_maze)({x,y, (size_t)MazeOfDigitsChannels::Walls}))
+				rgba = wall_color;
+			else {
+				unsigned short digit = (*displayed_maze)({x,y, (size_t)MazeOfDigitsChannels::Digits});
+				rgba = digit_colormap.color(digit);
+			}//: else
+
+			// Quad covering the cell.
+			float x0 = float(x) * w_scale_;
+			float y0 = float(y) * h_scale_;
+			float x1 = x0 + w_scale_;
+			float y1 = y0 + h_scale_;
+			*vertex++ = x0; *vertex++ = y0;
+			*vertex++ = x1; *vertex++ = y0;
+			*vertex++ = x1; *vertex++ = y1;
+			*vertex++ = x0; *vertex++ = y1;
+			*color++ = rgba; *color++ = rgba; *color++ = rgba; *color++ = rgba;
+		}//: for
+	}//: for
+
+	glEnableClientState(GL_VERTEX_ARRAY);
+	glEnableClientState(GL_COLOR_ARRAY);
+	glVertexPointer(2, GL_FLOAT, 0, cell_vertices.data());
+	glColorPointer(4, GL_UNSIGNED_BYTE, 0, cell_colors.data());
+	glDrawArrays(GL_QUADS, 0, (GLsizei)(4 * w_tensor_ * h_tensor_));
+	glDisableClientState(GL_COLOR_ARRAY);
+	glDisableClientState(GL_VERTEX_ARRAY);
+}
+
+void WindowMazeOfDigits::uploadValuePolicy() {
+	uploaded_version = value_policy_version;
+	arrow_vertex_count = 0;
+	// Invalid or empty tensor - drop values of the previous one.
+	if ((value_policy == nullptr) || (value_policy->dims().size() < 3) ||
+			(value_policy->dim(0) * value_policy->dim(1) * value_policy->dim(2) == 0)) {
+		value_texture.release();
+		return;
+	}//: if
+	size_t width = value_policy->dim(0);
+	size_t height = value_policy->dim(1);
+	size_t actions = value_policy->dim(2);
+
+	// Values and best actions of cells.
+	values.resize(width * height);
+	arrow_vertices.clear();
+	// Directions of actions (N, E, S, W) - y axis points down.
+	const float directions[4][2] = { {0.0f, -1.0f}, {1.0f, 0.0f}, {0.0f, 1.0f}, {-1.0f, 0.0f} };
+	for (size_t y = 0; y < height; y++) {
+		for (size_t x = 0; x < width; x++) {
+			float best = (*value_policy)({x, y, 0});
+			float worst = best;
+			size_t best_action = 0;
+			for (size_t a = 1; a < actions; a++) {
+				float value = (*value_policy)({x, y, a});
+				if (value > best) {
+					best = value;
+					best_action = a;
+				}//: if
+				worst = std::min(worst, value);
+			}//: for
+			values[y * width + x] = best;
+
+			// No arrows if all actions are equally good (e.g. walls or unvisited cells).
+			if ((actions < 2) || (best == worst) || (best_action > 3))
+				continue;
+			float dx = directions[best_action][0];
+			float dy = directions[best_action][1];
+			float cx = (float)x + 0.5f;
+			float cy = (float)y + 0.5f;
+			float tip_x = cx + 0.3f * dx;
+			float tip_y = cy + 0.3f * dy;
+			// Shaft and two halves of the head.
+			float segments[] = {
+				cx - 0.3f * dx, cy - 0.3f * dy, tip_x, tip_y,
+				tip_x, tip_y, tip_x - 0.15f * dx - 0.12f * dy, tip_y - 0.15f * dy + 0.12f * dx,
+				tip_x, tip_y, tip_x - 0.15f * dx + 0.12f * dy, tip_y - 0.15f * dy - 0.12f * dx };
+			arrow_vertices.insert(arrow_vertices.end(), segments, segments + 12);
+		}//: for
+	}//: for
+
+	// Upload values.
+	value_rgba.resize(values.size());
+	float min = *std::min_element(values.begin(), values.end());
+	float max = *std::max_element(values.begin(), values.end());
+	value_colormap.apply(values.data(), values.size(), min, max, value_rgba.data());
+	value_texture.uploadRGBA(width, height, value_rgba.data());
+
+	// Upload arrows.
+	arrow_vertex_count = arrow_vertices.size() / 2;
+	if (arrow_vertex_count == 0)
+		return;
+	if (arrow_buffer_id == 0)
+		glGenBuffers(1, &arrow_buffer_id);
+	glBindBuffer(GL_ARRAY_BUFFER, arrow_buffer_id);
+	glBufferData(GL_ARRAY_BUFFER, arrow_vertices.size() * sizeof(float), arrow_vertices.data(), GL_DYNAMIC_DRAW);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void WindowMazeOfDigits::drawValuePolicy(float w_scale_, float h_scale_) {
+	if (value_policy == nullptr)
+		return;
+	if (uploaded_version != value_policy_version)
+		uploadValuePolicy();
+
+	// Semi-transparent value layer, covering the cells of the maze.
+	if (show_values && value_texture.isAllocated()) {
+		glEnable(GL_TEXTURE_2D);
+		glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
+		glColor4f(1.0f, 1.0f, 1.0f, 0.6f);
+		value_texture.bind();
+		value_texture.draw(0.0f, 0.0f, (float)value_texture.getHeight() * h_scale_, (float)value_texture.getWidth() * w_scale_);
+		value_texture.unbind();
+		glDisable(GL_TEXTURE_2D);
+	}//: if
+
+	// Arrows are stored in cell coordinates - scale them to the window. Arrows in cells smaller than a few pixels would not be readable anyway.
+	if (show_policy && (arrow_vertex_count > 0) && (std::min(w_scale_, h_scale_) >= min_arrow_cell_size)) {
+		glPushMatrix();
+		glScalef(w_scale_, h_scale_, 1.0f);
+		glColor4f(1.0f, 1.0f, 1.0f, 0.9f);
+		glLineWidth(1.5f);
+		glBindBuffer(GL_ARRAY_BUFFER, arrow_buffer_id);
+		glEnableClientState(GL_VERTEX_ARRAY);
+		glVertexPointer(2, GL_FLOAT, 0, 0);
+		glDrawArrays(GL_LINES, 0, (GLsizei)arrow_vertex_count);
+		glDisableClientState(GL_VERTEX_ARRAY);
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+		glPopMatrix();
+	}//: if
+}
+
 void WindowMazeOfDigits::setPathPointer(std::shared_ptr<std::vector <mic::types::Position2D> > saccadic_path_) {
 	// Enter critical section.
 	APP_DATA_SYNCHRONIZATION_SCOPED_LOCK();
@@ -196,6 +364,16 @@ void WindowMazeOfDigits::setPathPointer(std::shared_ptr<std::vector <mic::types:
 	// End of critical section.
 }
 
+void WindowMazeOfDigits::setPathPointers(const std::vector<std::shared_ptr<std::vector <mic::types::Position2D> > > & agent_paths_) {
+	// Enter critical section.
+	APP_DATA_SYNCHRONIZATION_SCOPED_LOCK();
+
+	trajectories.setPaths(agent_paths_);
+	// End of critical section.
+}
+
+
+const float WindowMazeOfDigits::min_arrow_cell_size = 6.0f;
 
 } /* namespace visualization */
 } /* namespace opengl */
@@ -24,6 +24,9 @@
 #define SRC_OPENGL_VISUALIZATION_WINDOWMAZEOFDIGITS_HPP_
 
 #include <opengl/visualization/Window.hpp>
+#include <opengl/visualization/TrajectoryBuffer.hpp>
+#include <opengl/visualization/Colormap.hpp>
+#include <opengl/visualization/Texture2D.hpp>
 
 // Dependencies on core types.
 #include <types/TensorTypes.hpp>
@@ -49,6 +52,9 @@ enum class MazeOfDigitsChannels : std::size_t
 
 /*!
  * \brief OpenGL-based window responsible for displaying maze of digits (0-9) in a heat map-like form.
+ *
+ * Optionally displays values and policy (e.g. Q-values of the agent) - a heat layer with values of cells and arrows pointing in directions of the best actions.
+ * Both are uploaded (to a texture and a vertex buffer object respectively) only when a new version of the value/policy tensor is published and drawn with a single call each.
  * \author tkornuta
  */
 class WindowMazeOfDigits: public Window {
@@ -81,8 +87,53 @@ public:
 	 */
 	void setPathPointer(std::shared_ptr<std::vector <mic::types::Position2D> > saccadic_path_);
 
+	/*!
+	 * Sets pointers to paths of multiple agents (e.g. hundreds of concurrently acting agents), each drawn in its own colour.
+	 * Paths are expected to grow - only the new positions are uploaded during refresh. Trajectory of an agent is rebuilt when its path gets shorter or is replaced by another one.
+	 * @param agent_paths_ Vector of paths (a path is a sequence of consecutive agent positions).
+	 */
+	void setPathPointers(const std::vector<std::shared_ptr<std::vector <mic::types::Position2D> > > & agent_paths_);
+
+	/*!
+	 * Sets pointer to displayed values/policy - must be called after every change of the tensor (every call publishes a new version).
+	 * @param value_policy_ Tensor of size width x height x actions, storing values of actions in cells (e.g. Q-values, actions in the N, E, S, W order).
+	 * Value of a cell is the max value of its actions, arrow points in the direction of the best one. A single channel is displayed as values only.
+	 */
+	void setValuePolicyPointer(mic::types::TensorXfPtr value_policy_);
+
+	/*!
+	 * Shows/hides the value layer.
+	 */
+	void keyhandlerToggleValues(void);
+
+	/*!
+	 * Shows/hides the policy arrows.
+	 */
+	void keyhandlerTogglePolicy(void);
+
 private:
 
+	/*!
+	 * Draws cells of the maze (colours of digits and walls) with a single call.
+	 * @param w_tensor_ Width of the maze.
+	 * @param h_tensor_ Height of the maze.
+	 * @param w_scale_ Width of a cell (in pixels).
+	 * @param h_scale_ Height of a cell (in pixels).
+	 */
+	void drawCells(size_t w_tensor_, size_t h_tensor_, float w_scale_, float h_scale_);
+
+	/*!
+	 * Computes values and best actions of cells, uploads the value layer to the texture and arrows to the buffer object.
+	 */
+	void uploadValuePolicy();
+
+	/*!
+	 * Draws the value layer and the policy arrows (uploading them first if a new version was published).
+	 * @param w_scale_ Width of a cell (in pixels).
+	 * @param h_scale_ Height of a cell (in pixels).
+	 */
+	void drawValuePolicy(float w_scale_, float h_scale_);
+
 	/*!
 	 * Pointer to displayed matrix.
 	 */
@@ -91,6 +142,57 @@ private:
 	/// Saccadic path to be displayed - a sequence of consecutive agent positions.
 	std::shared_ptr<std::vector <mic::types::Position2D> > saccadic_path;
 
+	/// Trajectories of multiple agents, stored in a single vertex buffer object.
+	TrajectoryBuffer trajectories;
+
+	/// Colormap used for colouring digits.
+	Colormap digit_colormap;
+
+	/// Vertices of cells (reused between frames).
+	std::vector<float> cell_vertices;
+
+	/// Colours of cells (reused between frames).
+	std::vector<uint32_t> cell_colors;
+
+	/// Values/policy to be displayed.
+	mic::types::TensorXfPtr value_policy;
+
+	/// Version of the values/policy, incremented on every publication.
+	size_t value_policy_version;
+
+	/// Version of the values/policy that was uploaded.
+	size_t uploaded_version;
+
+	/// Flag indicating whether the value layer is displayed.
+	bool show_values;
+
+	/// Flag indicating whether the policy arrows are displayed.
+	bool show_policy;
+
+	/// Colormap used for colouring values.
+	Colormap value_colormap;
+
+	/// Texture storing the coloured values (a texel per cell).
+	Texture2D value_texture;
+
+	/// Values of cells.
+	std::vector<float> values;
+
+	/// Colours of values.
+	std::vector<uint32_t> value_rgba;
+
+	/// Vertices of arrows (in cell coordinates, so resizing of the window does not require upload).
+	std::vector<float> arrow_vertices;
+
+	/// Id of the vertex buffer object storing arrows.
+	GLuint arrow_buffer_id;
+
+	/// Number of vertices of arrows stored in the buffer object.
+	size_t arrow_vertex_count;
+
+	/// Min size of a cell (in pixels) for which the arrows are drawn.
+	static const float min_arrow_cell_size;
+
 };
 
 } /* namespace visualization */
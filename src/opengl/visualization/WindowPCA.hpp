@@ -0,0 +1,464 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file WindowPCA.hpp
+ * \brief Window displaying projection of high-dimensional activations onto their principal components.
+ * \author tkornuta
+ * \date Oct 18, 2026
+ */
+
+#ifndef SRC_OPENGL_VISUALIZATION_WINDOWPCA_HPP_
+#define SRC_OPENGL_VISUALIZATION_WINDOWPCA_HPP_
+
+#include <opengl/visualization/Window.hpp>
+#include <opengl/visualization/WindowManager.hpp>
+#include <opengl/visualization/Colormap.hpp>
+#include <opengl/visualization/FramePipeline.hpp>
+
+// Dependencies on core types.
+#include <types/MatrixTypes.hpp>
+
+#include <Eigen/Dense>
+#include <boost/bind.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <sstream>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace mic {
+namespace opengl {
+namespace visualization {
+
+/*!
+ * \brief OpenGL-based window displaying projection of activations (N samples x D features) onto their first two or three principal components.
+ *
+ * Principal components are computed in a background thread (see FramePipeline) by a randomized subspace iteration.
+ * The basis computed for the previous batch is the starting point for the next one, so during training a couple of iterations per batch are enough to follow the changes of activations,
+ * and the signs of components are kept consistent between batches, so the projection does not flip.
+ * The GL thread only takes a snapshot of the published batch and uploads the computed projection to a vertex buffer object.
+ * \author tkornuta
+ * \tparam eT Precision (float/double) (DEFAULT=float).
+ */
+template <typename eT = float>
+class WindowPCA: public Window {
+public:
+	/*!
+	 * Constructor.
+	 */
+	WindowPCA(std::string name_ = "WindowPCA",
+			unsigned int position_x_ = 0, unsigned int position_y_ = 0,
+			unsigned int width_ = 512, unsigned int height_ = 512) :
+		Window(name_, position_x_, position_y_, width_, height_),
+		display_3d(false),
+		rotation_x(20.0f), rotation_y(-30.0f),
+		dragging(false), drag_x(0), drag_y(0),
+		point_size(2.0f),
+		number_of_points(0),
+		number_of_components(0),
+		buffer_id(0),
+		positions_bytes(0),
+		label_colormap(Colormap_Categorical),
+		iterations(2),
+		data_published(false),
+		pipeline(boost::bind(&WindowPCA<eT>::prepareFrame, this, _1))
+	{
+		// Register additional key handler.
+		REGISTER_KEY_HANDLER('3', "3 - toggles 2D/3D projection", &WindowPCA<eT>::keyhandlerToggle3D);
+	}
+
+	/*!
+	 * Destructor. Releases the buffer object.
+	 */
+	virtual ~WindowPCA() {
+		if (buffer_id != 0)
+			glDeleteBuffers(1, &buffer_id);
+	}
+
+	/*!
+	 * Toggles between projection onto two and three principal components.
+	 */
+	void keyhandlerToggle3D(void) {
+		// Enter critical section.
+		APP_DATA_SYNCHRONIZATION_SCOPED_LOCK();
+		display_3d = !display_3d;
+		if (display_3d)
+			LOG(LINFO) << "Project onto three principal components (drag to rotate)";
+		else
+			LOG(LINFO) << "Project onto two principal components";
+		// End of critical section.
+	}
+
+	/*!
+	 * Sets number of iterations of the subspace iteration performed per batch.
+	 * @param iterations_ Number of iterations.
+	 */
+	void setIterations(size_t iterations_) {
+		// Enter critical section.
+		APP_DATA_SYNCHRONIZATION_SCOPED_LOCK();
+		iterations = std::max<size_t>(1, iterations_);
+		// End of critical section.
+	}
+
+	/*!
+	 * Sets size of drawn points.
+	 * @param size_ Size (in pixels).
+	 */
+	void setPointSize(float size_) {
+		// Enter critical section.
+		APP_DATA_SYNCHRONIZATION_SCOPED_LOCK();
+		point_size = size_;
+		// End of critical section.
+	}
+
+	/*!
+	 * Handles mouse buttons - left button starts/stops rotation of the 3D projection.
+	 */
+	void mouseHandler(int button, int state, int x, int y) {
+		// Enter critical section.
+		APP_DATA_SYNCHRONIZATION_SCOPED_LOCK();
+		if (button == GLUT_LEFT_BUTTON) {
+			dragging = (state == GLUT_DOWN);
+			drag_x = x;
+			drag_y = y;
+		}//: if
+		// End of critical section.
+	}
+
+	/*!
+	 * Rotates the 3D projection when dragged.
+	 * @param x X coordinate of the mouse pointer.
+	 * @param y Y coordinate of the mouse pointer.
+	 */
+	void motionHandler(int x, int y) {
+		// Enter critical section.
+		APP_DATA_SYNCHRONIZATION_SCOPED_LOCK();
+		if (dragging) {
+			rotation_y += 0.5f * (float)(x - drag_x);
+			rotation_x += 0.5f * (float)(y - drag_y);
+			drag_x = x;
+			drag_y = y;
+		}//: if
+		// End of critical section.
+	}
+
+	/*!
+	 * Refreshes the content of the window.
+	 */
+	void displayHandler(void){
+		LOG(LTRACE) << "WindowPCA::Display handler of window " << glutGetWindow();
+		// Enter critical section.
+		APP_DATA_SYNCHRONIZATION_SCOPED_LOCK();
+
+		// Clear buffer.
+		glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+		// Pass the published batch to the pipeline, upload the projection it computed.
+		if (data_published)
+			submitFrame();
+		std::shared_ptr<Frame> frame = pipeline.takePrepared();
+		if (frame != nullptr)
+			uploadFrame(*frame);
+
+		if (number_of_points > 0)
+			drawPoints();
+
+		draw_text(4.0f, (float)viewport_height - 6.0f, const_cast<char*>(variance_label.c_str()), 0.7f, 0.7f, 0.7f, 1.0f, GLUT_BITMAP_HELVETICA_10);
+
+		// Swap buffers.
+		glutSwapBuffers();
+
+		// End of critical section.
+	}
+
+	/*!
+	 * Sets displayed activations.
+	 * @param activations_ptr_ Pointer to the matrix of activations (one sample per row, features in columns).
+	 * @param labels_ptr_ Pointer to labels of samples (optional, used for colouring).
+	 */
+	void setDataPointerSynchronized(mic::types::MatrixPtr<eT> activations_ptr_, std::shared_ptr<std::vector<size_t> > labels_ptr_ = nullptr) {
+		// Enter critical section.
+		APP_DATA_SYNCHRONIZATION_SCOPED_LOCK();
+		setDataPointerUnsynchronized(activations_ptr_, labels_ptr_);
+		// End of critical section.
+	}
+
+	/*!
+	 * Sets displayed activations. Unsynchronized i.e. must be used inside of manually synchronized section.
+	 * @param activations_ptr_ Pointer to the matrix of activations (one sample per row, features in columns).
+	 * @param labels_ptr_ Pointer to labels of samples (optional, used for colouring).
+	 */
+	void setDataPointerUnsynchronized(mic::types::MatrixPtr<eT> activations_ptr_, std::shared_ptr<std::vector<size_t> > labels_ptr_ = nullptr) {
+		activations_ptr = activations_ptr_;
+		labels_ptr = labels_ptr_;
+		data_published = true;
+	}
+
+private:
+
+	/*!
+	 * \brief Structure representing a frame passing through the pipeline - snapshot of the published activations and their projection.
+	 */
+	struct Frame {
+		/// Snapshot of activations.
+		Eigen::MatrixXf activations;
+
+		/// Snapshot of labels.
+		std::vector<size_t> labels;
+
+		/// Number of iterations of the subspace iteration.
+		size_t iterations;
+
+		/// Number of computed components (up to three).
+		size_t components;
+
+		/// Projection of samples (interleaved coordinates, unused components are zero), scaled to <-1,1>.
+		Eigen::Matrix<float, 3, Eigen::Dynamic> projection;
+
+		/// Fractions of variance explained by the components.
+		float explained[3];
+	};
+
+	/*!
+	 * Takes snapshot of the published activations and submits it to the pipeline (GL thread, inside of the critical section).
+	 */
+	void submitFrame() {
+		data_published = false;
+		if ((activations_ptr == nullptr) || (activations_ptr->rows() < 2) || (activations_ptr->cols() < 1))
+			return;
+		std::shared_ptr<Frame> frame = std::make_shared<Frame>();
+		frame->activations = activations_ptr->template cast<float>();
+		if ((labels_ptr != nullptr) && (labels_ptr->size() >= (size_t)activations_ptr->rows()))
+			frame->labels.assign(labels_ptr->begin(), labels_ptr->begin() + activations_ptr->rows());
+		frame->iterations = iterations;
+		pipeline.submit(frame);
+	}
+
+	/*!
+	 * Computes principal components of activations and projects samples onto them (pipeline thread).
+	 * Basis is warm-started from the one computed for the previous frame.
+	 * @param frame_ Frame.
+	 */
+	void prepareFrame(Frame & frame_) {
+		Eigen::MatrixXf & X = frame_.activations;
+		size_t samples = X.rows();
+		size_t features = X.cols();
+		frame_.components = std::min<size_t>(3, std::min(samples, features));
+
+		// Center.
+		X.rowwise() -= X.colwise().mean();
+
+		// Oversampled subspace - converges faster than the components alone.
+		size_t subspace = std::min(frame_.components + oversampling, features);
+		if (((size_t)basis.rows() != features) || ((size_t)basis.cols() != subspace)) {
+			// Random start (first batch or the number of features changed).
+			basis = Eigen::MatrixXf::Random(features, subspace);
+			previous_components.resize(0, 0);
+		}//: if
+
+		// Subspace iteration: Q = orth(X^T X Q).
+		Eigen::MatrixXf Y;
+		for (size_t i = 0; i < frame_.iterations; i++) {
+			Eigen::HouseholderQR<Eigen::MatrixXf> qr(X.transpose() * (X * basis));
+			basis = qr.householderQ() * Eigen::MatrixXf::Identity(features, subspace);
+		}//: for
+
+		// Rayleigh-Ritz - rotate the basis so its columns are ordered by the variance.
+		Y = X * basis;
+		Eigen::SelfAdjointEigenSolver<Eigen::MatrixXf> eigen(Y.transpose() * Y);
+		Eigen::MatrixXf rotation = eigen.eigenvectors().rowwise().reverse();
+		basis = basis * rotation;
+
+		// Keep signs consistent with the previous batch.
+		Eigen::MatrixXf components = basis.leftCols(frame_.components);
+		if (previous_components.cols() == components.cols()) {
+			for (size_t c = 0; c < frame_.components; c++)
+				if (components.col(c).dot(previous_components.col(c)) < 0.0f)
+					components.col(c) *= -1.0f;
+		}//: if
+		previous_components = components;
+
+		// Explained variance.
+		float total = X.squaredNorm();
+		Eigen::VectorXf variances = eigen.eigenvalues().reverse();
+		for (size_t c = 0; c < 3; c++)
+			frame_.explained[c] = ((c < frame_.components) && (total > 0.0f)) ? variances(c) / total : 0.0f;
+
+		// Project and scale.
+		frame_.projection.setZero(3, samples);
+		frame_.projection.topRows(frame_.components) = (X * components).transpose();
+		float range = frame_.projection.cwiseAbs().maxCoeff();
+		if (range > 0.0f)
+			frame_.projection /= range;
+
+		// Snapshot is no longer needed.
+		X.resize(0, 0);
+	}
+
+	/*!
+	 * Uploads projection and colours of samples to the buffer object (GL thread, inside of the critical section).
+	 * @param frame_ Prepared frame.
+	 */
+	void uploadFrame(const Frame & frame_) {
+		number_of_points = frame_.projection.cols();
+		number_of_components = frame_.components;
+
+		colors.resize(number_of_points);
+		if (frame_.labels.size() >= number_of_points) {
+			for (size_t i = 0; i < number_of_points; i++)
+				colors[i] = label_colormap.color(frame_.labels[i]);
+		} else
+			std::fill(colors.begin(), colors.end(), Colormap::pack(0.5f, 0.7f, 1.0f));
+
+		// Upload positions followed by colours.
+		if (buffer_id == 0)
+			glGenBuffers(1, &buffer_id);
+		glBindBuffer(GL_ARRAY_BUFFER, buffer_id);
+		positions_bytes = 3 * number_of_points * sizeof(float);
+		glBufferData(GL_ARRAY_BUFFER, positions_bytes + colors.size() * sizeof(uint32_t), NULL, GL_STREAM_DRAW);
+		glBufferSubData(GL_ARRAY_BUFFER, 0, positions_bytes, frame_.projection.data());
+		glBufferSubData(GL_ARRAY_BUFFER, positions_bytes, colors.size() * sizeof(uint32_t), colors.data());
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+		// Update label.
+		std::ostringstream stream;
+		stream.precision(3);
+		stream << number_of_points << " samples, explained variance:";
+		for (size_t c = 0; c < number_of_components; c++)
+			stream << " " << 100.0f * frame_.explained[c] << "%";
+		variance_label = stream.str();
+	}
+
+	/*!
+	 * Draws projected samples with a single call.
+	 */
+	void drawPoints() {
+		float scale = 0.45f * (float)std::min(viewport_width, viewport_height);
+
+		glPushMatrix();
+		// Flatten the (rotated) projection onto the screen, y pointing up.
+		glTranslatef((float)viewport_width / 2.0f, (float)viewport_height / 2.0f, 0.0f);
+		glScalef(scale, -scale, 0.0f);
+		if (display_3d && (number_of_components == 3)) {
+			glRotatef(rotation_x, 1.0f, 0.0f, 0.0f);
+			glRotatef(rotation_y, 0.0f, 1.0f, 0.0f);
+		}//: if
+
+		glPointSize(point_size);
+		glBindBuffer(GL_ARRAY_BUFFER, buffer_id);
+		glEnableClientState(GL_VERTEX_ARRAY);
+		glEnableClientState(GL_COLOR_ARRAY);
+		// In 2D only the first two coordinates are used.
+		glVertexPointer((display_3d ? 3 : 2), GL_FLOAT, 3 * sizeof(float), 0);
+		glColorPointer(4, GL_UNSIGNED_BYTE, 0, (const GLvoid*)positions_bytes);
+		glDrawArrays(GL_POINTS, 0, (GLsizei)number_of_points);
+		glDisableClientState(GL_COLOR_ARRAY);
+		glDisableClientState(GL_VERTEX_ARRAY);
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+		glPointSize(1.0f);
+
+		// Axes of components.
+		glLineWidth(1.0f);
+		glBegin(GL_LINES);
+		glColor4f(1.0f, 0.3f, 0.3f, 0.6f);
+		glVertex3f(0.0f, 0.0f, 0.0f); glVertex3f(1.0f, 0.0f, 0.0f);
+		glColor4f(0.3f, 1.0f, 0.3f, 0.6f);
+		glVertex3f(0.0f, 0.0f, 0.0f); glVertex3f(0.0f, 1.0f, 0.0f);
+		if (display_3d && (number_of_components == 3)) {
+			glColor4f(0.3f, 0.3f, 1.0f, 0.6f);
+			glVertex3f(0.0f, 0.0f, 0.0f); glVertex3f(0.0f, 0.0f, 1.0f);
+		}//: if
+		glEnd();
+
+		glPopMatrix();
+	}
+
+	/// Pointer to displayed activations.
+	mic::types::MatrixPtr<eT> activations_ptr;
+
+	/// Pointer to labels of samples.
+	std::shared_ptr<std::vector<size_t> > labels_ptr;
+
+	/// Flag indicating whether the projection onto three components is displayed.
+	bool display_3d;
+
+	/// Rotation of the 3D projection around the x axis (in degrees).
+	float rotation_x;
+
+	/// Rotation of the 3D projection around the y axis (in degrees).
+	float rotation_y;
+
+	/// Flag indicating that the projection is being rotated.
+	bool dragging;
+
+	/// X coordinate of the mouse pointer during dragging.
+	int drag_x;
+
+	/// Y coordinate of the mouse pointer during dragging.
+	int drag_y;
+
+	/// Size of drawn points (in pixels).
+	float point_size;
+
+	/// Number of uploaded points.
+	size_t number_of_points;
+
+	/// Number of components of uploaded points.
+	size_t number_of_components;
+
+	/// Id of the vertex buffer object storing positions and colours of points.
+	GLuint buffer_id;
+
+	/// Size of positions stored in the buffer object (colours follow them).
+	size_t positions_bytes;
+
+	/// Colours of uploaded points.
+	std::vector<uint32_t> colors;
+
+	/// Colours of labels.
+	Colormap label_colormap;
+
+	/// Label displaying explained variance.
+	std::string variance_label;
+
+	/// Number of iterations of the subspace iteration performed per batch.
+	size_t iterations;
+
+	/// Orthonormal basis of the (oversampled) subspace - used only by the pipeline thread.
+	Eigen::MatrixXf basis;
+
+	/// Components computed for the previous batch - used only by the pipeline thread.
+	Eigen::MatrixXf previous_components;
+
+	/// Flag indicating that new activations were published and must be submitted to the pipeline.
+	bool data_published;
+
+	/// Number of additional vectors of the subspace.
+	static const size_t oversampling = 5;
+
+	/// Pipeline computing projections in the background (must be the last member - its thread uses the ones above).
+	FramePipeline<Frame> pipeline;
+};
+
+} /* namespace visualization */
+} /* namespace opengl */
+} /* namespace mic */
+
+#endif /* SRC_OPENGL_VISUALIZATION_WINDOWPCA_HPP_ */
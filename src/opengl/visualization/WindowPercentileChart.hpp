@@ -0,0 +1,358 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file WindowPercentileChart.hpp
+ * \brief Contains declaration (and definition) of a window displaying percentile bands of a noisy series of values.
+ * \author tkornuta
+ * \date Oct 18, 2026
+ */
+
+#ifndef SRC_OPENGL_VISUALIZATION_WINDOWPERCENTILECHART_HPP_
+#define SRC_OPENGL_VISUALIZATION_WINDOWPERCENTILECHART_HPP_
+
+#include <opengl/visualization/Window.hpp>
+#include <opengl/visualization/WindowManager.hpp>
+#include <opengl/visualization/QuantileSketch.hpp>
+
+// Dependencies on core types.
+#include <types/MatrixTypes.hpp>
+
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace mic {
+namespace opengl {
+namespace visualization {
+
+/*!
+ * \brief OpenGL-based window displaying distribution of a noisy series of values (e.g. losses of consecutive samples) - median along with the p25-p75 and p5-p95 bands.
+ *
+ * Samples are not stored - every bucket of consecutive samples is summarized by a quantile sketch, hence the memory is bounded by the number of buckets and the size of sketches, regardless of the number of samples.
+ * When the number of buckets reaches its limit, neighbouring buckets are merged, so the chart always covers the whole history (with twice as large buckets).
+ * Percentiles are cached and recomputed only for the buckets that changed since the last frame.
+ * \author tkornuta
+ * \tparam eT Precision (float/double) (DEFAULT=float).
+ */
+template <typename eT = float>
+class WindowPercentileChart: public Window {
+public:
+	/*!
+	 * Constructor.
+	 * @param bucket_size_ Initial number of samples summarized by a bucket (DEFAULT=100).
+	 * @param max_buckets_ Max number of buckets (DEFAULT=256).
+	 * @param compression_ Compression of quantile sketches (DEFAULT=100).
+	 */
+	WindowPercentileChart(std::string name_ = "WindowPercentileChart",
+			unsigned int position_x_ = 0, unsigned int position_y_ = 0,
+			unsigned int width_ = 1024, unsigned int height_ = 256,
+			size_t bucket_size_ = 100, size_t max_buckets_ = 256, double compression_ = 100.0) :
+		Window(name_, position_x_, position_y_, width_, height_),
+		bucket_size(std::max<size_t>(1, bucket_size_)),
+		max_buckets(std::max<size_t>(2, max_buckets_ + (max_buckets_ % 2))),
+		compression(compression_),
+		number_of_samples(0),
+		samples_in_bucket(0)
+	{
+		min_value = max_value = 0.0f;
+	}
+
+	/*!
+	 * Destructor.
+	 */
+	virtual ~WindowPercentileChart() { }
+
+	/*!
+	 * Refreshes the content of the window.
+	 */
+	void displayHandler(void){
+		LOG(LTRACE) << "WindowPercentileChart::Display handler of window " << glutGetWindow();
+		// Enter critical section.
+		APP_DATA_SYNCHRONIZATION_SCOPED_LOCK();
+
+		// Clear buffer.
+		glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+		// Chart area.
+		plot_x0 = (float)margin_left;
+		plot_y0 = (float)margin;
+		plot_x1 = std::max(plot_x0 + 1.0f, (float)viewport_width - margin);
+		plot_y1 = std::max(plot_y0 + 1.0f, (float)viewport_height - margin_bottom);
+
+		if (!buckets.empty()) {
+			updatePercentiles();
+			drawBands();
+		}//: if
+
+		drawAxes();
+
+		// Swap buffers.
+		glutSwapBuffers();
+
+		// End of critical section.
+	}
+
+	/*!
+	 * Adds sample to the chart.
+	 * @param value_ Value of the sample.
+	 */
+	void addSampleSynchronized(eT value_) {
+		// Enter critical section.
+		APP_DATA_SYNCHRONIZATION_SCOPED_LOCK();
+		addSampleUnsynchronized(value_);
+		// End of critical section.
+	}
+
+	/*!
+	 * Adds sample to the chart. Unsynchronized i.e. must be used inside of manually synchronized section.
+	 * @param value_ Value of the sample.
+	 */
+	void addSampleUnsynchronized(eT value_) {
+		// Start a new bucket.
+		if (buckets.empty() || (samples_in_bucket == bucket_size)) {
+			if (buckets.size() == max_buckets)
+				mergeBuckets();
+			buckets.push_back(QuantileSketch(compression));
+			percentiles.resize(buckets.size() * number_of_percentiles);
+			changed.push_back(true);
+			samples_in_bucket = 0;
+		}//: if
+		buckets.back().add((double)value_);
+		changed.back() = true;
+		samples_in_bucket++;
+		number_of_samples++;
+	}
+
+	/*!
+	 * Adds all elements of a matrix as consecutive samples (e.g. losses of samples of a batch).
+	 * @param samples_ptr_ Pointer to the matrix of samples.
+	 */
+	void addSamplesSynchronized(mic::types::MatrixPtr<eT> samples_ptr_) {
+		// Enter critical section.
+		APP_DATA_SYNCHRONIZATION_SCOPED_LOCK();
+		addSamplesUnsynchronized(samples_ptr_);
+		// End of critical section.
+	}
+
+	/*!
+	 * Adds all elements of a matrix as consecutive samples. Unsynchronized i.e. must be used inside of manually synchronized section.
+	 * @param samples_ptr_ Pointer to the matrix of samples.
+	 */
+	void addSamplesUnsynchronized(mic::types::MatrixPtr<eT> samples_ptr_) {
+		if (samples_ptr_ == nullptr)
+			return;
+		const eT* data = samples_ptr_->data();
+		for (size_t i = 0; i < (size_t)samples_ptr_->size(); i++)
+			addSampleUnsynchronized(data[i]);
+	}
+
+	/*!
+	 * Removes all samples.
+	 */
+	void clear() {
+		// Enter critical section.
+		APP_DATA_SYNCHRONIZATION_SCOPED_LOCK();
+		buckets.clear();
+		percentiles.clear();
+		changed.clear();
+		number_of_samples = 0;
+		samples_in_bucket = 0;
+		// End of critical section.
+	}
+
+private:
+
+	/*!
+	 * Merges pairs of neighbouring buckets, halving their number and doubling their size.
+	 */
+	void mergeBuckets() {
+		for (size_t i = 0; i < buckets.size() / 2; i++) {
+			buckets[i] = buckets[2 * i];
+			buckets[i].merge(buckets[2 * i + 1]);
+		}//: for
+		buckets.resize(buckets.size() / 2);
+		changed.assign(buckets.size(), true);
+		bucket_size *= 2;
+	}
+
+	/*!
+	 * Recomputes percentiles of the changed buckets.
+	 */
+	void updatePercentiles() {
+		static const double levels[number_of_percentiles] = {0.05, 0.25, 0.5, 0.75, 0.95};
+		for (size_t i = 0; i < buckets.size(); i++)
+			if (changed[i]) {
+				for (size_t p = 0; p < number_of_percentiles; p++)
+					percentiles[i * number_of_percentiles + p] = (float)buckets[i].quantile(levels[p]);
+				changed[i] = false;
+			}//: if
+
+		// Range of the chart covers the p5-p95 bands.
+		min_value = percentiles[0];
+		max_value = percentiles[number_of_percentiles - 1];
+		for (size_t i = 0; i < buckets.size(); i++) {
+			min_value = std::min(min_value, percentiles[i * number_of_percentiles]);
+			max_value = std::max(max_value, percentiles[i * number_of_percentiles + number_of_percentiles - 1]);
+		}//: for
+		if (max_value <= min_value) {
+			min_value -= 0.5f;
+			max_value += 0.5f;
+		}//: if
+	}
+
+	/*!
+	 * Draws the bands as filled strips and the median as a line (in bucket/value units, scaled to the chart with the modelview transformation).
+	 */
+	void drawBands() {
+		size_t n = buckets.size();
+		// Every bucket spans one unit - a single bucket is drawn as a flat segment.
+		float x_step = (n > 1) ? 1.0f : 0.0f;
+		float x_offset = (n > 1) ? 0.5f : 0.0f;
+		float x_range = (n > 1) ? (float)n : 1.0f;
+
+		glPushMatrix();
+		glTranslatef(plot_x0, plot_y1, 0.0f);
+		glScalef((plot_x1 - plot_x0) / x_range, -(plot_y1 - plot_y0) / (max_value - min_value), 1.0f);
+		glTranslatef(0.0f, -min_value, 0.0f);
+		glEnableClientState(GL_VERTEX_ARRAY);
+
+		// Bands: p5-p95 and p25-p75.
+		const float band_alpha[2] = {0.25f, 0.5f};
+		for (size_t b = 0; b < 2; b++) {
+			strip.resize(8 * n);
+			size_t vertices = 0;
+			for (size_t i = 0; i < n; i++) {
+				float x = x_offset + x_step * i;
+				const float* p = &percentiles[i * number_of_percentiles];
+				strip[2 * vertices] = x;
+				strip[2 * vertices + 1] = p[b];
+				strip[2 * vertices + 2] = x;
+				strip[2 * vertices + 3] = p[number_of_percentiles - 1 - b];
+				vertices += 2;
+				if (n == 1) {
+					strip[2 * vertices] = 1.0f;
+					strip[2 * vertices + 1] = p[b];
+					strip[2 * vertices + 2] = 1.0f;
+					strip[2 * vertices + 3] = p[number_of_percentiles - 1 - b];
+					vertices += 2;
+				}//: if
+			}//: for
+			glColor4f(0.3f, 0.6f, 1.0f, band_alpha[b]);
+			glVertexPointer(2, GL_FLOAT, 0, strip.data());
+			glDrawArrays(GL_TRIANGLE_STRIP, 0, (GLsizei)vertices);
+		}//: for
+
+		// Median.
+		size_t vertices = 0;
+		for (size_t i = 0; i < n; i++) {
+			strip[2 * vertices] = x_offset + x_step * i;
+			strip[2 * vertices + 1] = percentiles[i * number_of_percentiles + number_of_percentiles / 2];
+			vertices++;
+		}//: for
+		if (n == 1) {
+			strip[2] = 1.0f;
+			strip[3] = strip[1];
+			vertices++;
+		}//: if
+		glLineWidth(2.0f);
+		glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
+		glVertexPointer(2, GL_FLOAT, 0, strip.data());
+		glDrawArrays(GL_LINE_STRIP, 0, (GLsizei)vertices);
+		glLineWidth(1.0f);
+
+		glDisableClientState(GL_VERTEX_ARRAY);
+		glPopMatrix();
+	}
+
+	/*!
+	 * Draws frame of the chart and labels.
+	 */
+	void drawAxes() {
+		draw_rectangle(plot_x0, plot_y0, plot_y1 - plot_y0, plot_x1 - plot_x0, 0.7f, 0.7f, 0.7f, 1.0f);
+		if (buckets.empty())
+			return;
+
+		std::ostringstream stream;
+		stream << max_value;
+		max_label = stream.str();
+		stream.str("");
+		stream << min_value;
+		min_label = stream.str();
+		stream.str("");
+		stream << "median, p25-p75, p5-p95 of " << number_of_samples << " samples (" << bucket_size << " per bucket)";
+		info_label = stream.str();
+
+		draw_text(2.0f, plot_y0 + 10.0f, const_cast<char*>(max_label.c_str()), 1.0f, 1.0f, 1.0f, 1.0f, GLUT_BITMAP_HELVETICA_10);
+		draw_text(2.0f, plot_y1, const_cast<char*>(min_label.c_str()), 1.0f, 1.0f, 1.0f, 1.0f, GLUT_BITMAP_HELVETICA_10);
+		draw_text(plot_x0, plot_y1 + 12.0f, const_cast<char*>(info_label.c_str()), 0.7f, 0.7f, 0.7f, 1.0f, GLUT_BITMAP_HELVETICA_10);
+	}
+
+	/// Number of displayed percentiles (p5, p25, p50, p75, p95).
+	static const size_t number_of_percentiles = 5;
+
+	/// Quantile sketches of buckets.
+	std::vector<QuantileSketch> buckets;
+
+	/// Cached percentiles of buckets.
+	std::vector<float> percentiles;
+
+	/// Flags indicating that buckets changed since the last frame.
+	std::vector<bool> changed;
+
+	/// Number of samples summarized by a bucket.
+	size_t bucket_size;
+
+	/// Max number of buckets.
+	size_t max_buckets;
+
+	/// Compression of quantile sketches.
+	double compression;
+
+	/// Number of added samples.
+	size_t number_of_samples;
+
+	/// Number of samples added to the last bucket.
+	size_t samples_in_bucket;
+
+	/// Range of the chart.
+	float min_value, max_value;
+
+	/// Chart area (in pixels).
+	float plot_x0, plot_y0, plot_x1, plot_y1;
+
+	/// Vertices of the drawn strip (reused between frames).
+	std::vector<GLfloat> strip;
+
+	/// Cached labels.
+	std::string min_label, max_label, info_label;
+
+	/// Left margin of the chart (room for labels of the y axis).
+	static const int margin_left = 40;
+
+	/// Bottom margin of the chart (room for the info label).
+	static const int margin_bottom = 20;
+
+	/// Top and right margins of the chart.
+	static const int margin = 10;
+};
+
+} /* namespace visualization */
+} /* namespace opengl */
+} /* namespace mic */
+
+#endif /* SRC_OPENGL_VISUALIZATION_WINDOWPERCENTILECHART_HPP_ */
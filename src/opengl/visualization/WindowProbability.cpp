@@ -24,20 +24,39 @@
 
 #include <opengl/visualization/WindowProbability.hpp>
 #include <opengl/visualization/WindowManager.hpp>
+#include <opengl/visualization/Colormap.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
 
 namespace mic {
 namespace opengl {
 namespace visualization {
 
+namespace {
+
+/// Colours of distributions (the first two are the colours of the original target/prediction bars).
+const float distribution_colors[][3] = {
+	{1.0f, 0.5f, 0.5f}, {0.5f, 1.0f, 0.5f}, {0.5f, 0.5f, 1.0f}, {1.0f, 1.0f, 0.5f},
+	{1.0f, 0.5f, 1.0f}, {0.5f, 1.0f, 1.0f}, {1.0f, 0.75f, 0.25f}, {0.75f, 0.75f, 0.75f}
+};
+
+/// Number of colours in the palette.
+const size_t distribution_colors_count = sizeof(distribution_colors) / sizeof(distribution_colors[0]);
+
+} //: namespace
+
 
 WindowProbability::WindowProbability(std::string name_,
 		unsigned int position_x_, unsigned int position_y_,
 		unsigned int width_ , unsigned int height_) :
-	Window(name_, position_x_, position_y_, width_, height_)
+	Window(name_, position_x_, position_y_, width_, height_),
+	top_k_mode(false),
+	top_k(10)
 {
-	// NULL pointer.
-	displayed_matrix1 = nullptr;
-	displayed_matrix2 = nullptr;
+	// Register additional key handler.
+	REGISTER_KEY_HANDLER('k', "k - toggles displaying of top-K elements", &WindowProbability::keyhandlerToggleTopK);
 }
 
 
@@ -57,100 +76,164 @@ void WindowProbability::displayHandler(void){
 
 	// Draw chart boundary.
 	glLineWidth(1.0f);
-	draw_rectangle(1.0f, 1.0f, (float)glutGet(GLUT_WINDOW_HEIGHT)*0.9, (float)glutGet(GLUT_WINDOW_WIDTH)-2.0f, 0.7f, 0.7f, 0.7f, 1.0f);
+	draw_rectangle(1.0f, 1.0f, (float)viewport_height*0.9, (float)viewport_width-2.0f, 0.7f, 0.7f, 0.7f, 1.0f);
 
-	if (displayed_matrix1 != nullptr){
+	// Elements of the longest distribution.
+	size_t elements = 0;
+	for (size_t i = 0; i < displayed_matrices.size(); i++) {
+		if (displayed_matrices[i] == nullptr)
+			continue;
 		// Assume vector (1d matrix).
-		assert(displayed_matrix1->cols() == 1);
+		assert(displayed_matrices[i]->cols() == 1);
+		elements = std::max(elements, (size_t)displayed_matrices[i]->rows());
+	}//: for
 
-/*		std::cout << "Drawing matrix: r =" << displayed_matrix1->rows() << " c=" << displayed_matrix1->cols() << std::endl;
-		std::cout << displayed_matrix1->transpose() << std::endl;*/
-		size_t elements = displayed_matrix1->rows();
-    	float* data_ptr = displayed_matrix1->data();
+	if (elements > 0) {
+		selectElements(elements);
+		drawBars();
+		drawLabels();
+	}//: if
 
-		// Compute scale.
-    	float scale_x = (float)glutGet(GLUT_WINDOW_WIDTH)/(float)(elements);
-    	float scale_y = (float)glutGet(GLUT_WINDOW_HEIGHT) * 0.9 - 1.0f;
+	// Swap buffers.
+	glutSwapBuffers();
 
-    	// Iterate through elements of the vector.
-		for (size_t x = 0; x < elements; x++) {
-			// Get value.
-			float val = data_ptr[x];
+	// End of critical section.
+}
 
-			glColor4f(1.0, 0.5, 0.5, 1.0);
-			glLineWidth(5.0);
-			glBegin(GL_LINES);
-			  glVertex2i(((float) (x+0.4) * scale_x), scale_y);
-			  glVertex2i(((float) (x+0.4) * scale_x), (float) (1.0-val) * scale_y);
-			glEnd();
 
-		}//: for
+void WindowProbability::keyhandlerToggleTopK(void) {
+	// Enter critical section.
+	APP_DATA_SYNCHRONIZATION_SCOPED_LOCK();
+	top_k_mode = !top_k_mode;
+	if (top_k_mode)
+		LOG(LINFO) << "Display top-" << top_k << " elements";
+	else
+		LOG(LINFO) << "Display all elements";
+	// End of critical section.
+}
 
-		// Print labels.
-		scale_y = (float)glutGet(GLUT_WINDOW_HEIGHT) * 0.97;
-		for (size_t x = 0; x < elements; x++) {
-			char* str_value = (char*)std::to_string(x).c_str();
-			draw_text((float) (x+0.45) * scale_x, scale_y, str_value, 1.0f, 1.0f, 1.0f, 1.0f, GLUT_BITMAP_HELVETICA_10);
-		}//: for
 
-	}//: if !null
+void WindowProbability::setTopK(size_t top_k_) {
+	// Enter critical section.
+	APP_DATA_SYNCHRONIZATION_SCOPED_LOCK();
+	top_k = std::max<size_t>(1, top_k_);
+	top_k_mode = true;
+	// End of critical section.
+}
 
-	if (displayed_matrix2 != nullptr){
-		// Assume vector (1d matrix).
-		assert(displayed_matrix2->cols() == 1);
 
-		size_t elements = displayed_matrix2->rows();
-    	float* data_ptr = displayed_matrix2->data();
+void WindowProbability::selectElements(size_t elements_) {
+	selected.resize(elements_);
+	for (size_t i = 0; i < elements_; i++)
+		selected[i] = i;
+	if ((!top_k_mode) || (elements_ <= top_k))
+		return;
 
-		// Compute scale.
-    	float scale_x = (float)glutGet(GLUT_WINDOW_WIDTH)/(float)(elements);
-    	float scale_y = (float)glutGet(GLUT_WINDOW_HEIGHT) * 0.9 - 1.0f;
+	// Partial selection - linear in the number of elements, only the top-K ones are sorted.
+	std::nth_element(selected.begin(), selected.begin() + top_k, selected.end(),
+			[this](size_t a_, size_t b_) { return score(a_) > score(b_); });
+	selected.resize(top_k);
+	std::sort(selected.begin(), selected.end(),
+			[this](size_t a_, size_t b_) { return score(a_) > score(b_); });
+}
 
-    	// Iterate through elements of the vector.
-		for (size_t x = 0; x < elements; x++) {
-			// Get value.
-			float val = data_ptr[x];
 
-			glColor4f(0.5, 1.0, 0.5, 1.0);
-			glLineWidth(5.0);
-			glBegin(GL_LINES);
-			  glVertex2i(((float) (x+0.6) * scale_x), scale_y);
-			  glVertex2i(((float) (x+0.6) * scale_x), (float) (1.0-val) * scale_y);
-			glEnd();
+float WindowProbability::score(size_t index_) const {
+	float result = -std::numeric_limits<float>::max();
+	for (size_t i = 0; i < displayed_matrices.size(); i++)
+		if ((displayed_matrices[i] != nullptr) && (index_ < (size_t)displayed_matrices[i]->rows()))
+			result = std::max(result, (*displayed_matrices[i])(index_, 0));
+	return result;
+}
 
-		}//: for
 
-		// Print labels.
-		scale_y = (float)glutGet(GLUT_WINDOW_HEIGHT) * 0.97;
-		for (size_t x = 0; x < elements; x++) {
-			char* str_value = (char*)std::to_string(x).c_str();
-			draw_text((float) (x+0.45) * scale_x, scale_y, str_value, 1.0f, 1.0f, 1.0f, 1.0f, GLUT_BITMAP_HELVETICA_10);
+void WindowProbability::drawBars() {
+	// Compute scale.
+	float scale_x = (float)viewport_width/(float)(selected.size());
+	float scale_y = (float)viewport_height * 0.9 - 1.0f;
+	size_t series = displayed_matrices.size();
+
+	// Bars of distributions are placed next to each other inside of the slot of an element.
+	float spacing = std::min(0.2f, 0.5f / (float)series);
+	float line_width = std::max(1.0f, std::min(5.0f, 0.8f * spacing * scale_x));
+
+	// Collect bars of all distributions.
+	bar_vertices.clear();
+	bar_colors.clear();
+	for (size_t i = 0; i < series; i++) {
+		if (displayed_matrices[i] == nullptr)
+			continue;
+		const float* data_ptr = displayed_matrices[i]->data();
+		size_t elements = displayed_matrices[i]->rows();
+		const float* color = distribution_colors[i % distribution_colors_count];
+		uint32_t rgba = Colormap::pack(color[0], color[1], color[2]);
+		for (size_t x = 0; x < selected.size(); x++) {
+			if (selected[x] >= elements)
+				continue;
+			float val = data_ptr[selected[x]];
+			float bar_x = ((float)x + 0.4f + (float)i * spacing) * scale_x;
+			bar_vertices.insert(bar_vertices.end(), {bar_x, scale_y, bar_x, (1.0f - val) * scale_y});
+			bar_colors.insert(bar_colors.end(), 2, rgba);
 		}//: for
+	}//: for
+	if (bar_vertices.empty())
+		return;
+
+	// Draw them with a single call.
+	glLineWidth(line_width);
+	glEnableClientState(GL_VERTEX_ARRAY);
+	glEnableClientState(GL_COLOR_ARRAY);
+	glVertexPointer(2, GL_FLOAT, 0, bar_vertices.data());
+	glColorPointer(4, GL_UNSIGNED_BYTE, 0, bar_colors.data());
+	glDrawArrays(GL_LINES, 0, (GLsizei) (bar_vertices.size() / 2));
+	glDisableClientState(GL_COLOR_ARRAY);
+	glDisableClientState(GL_VERTEX_ARRAY);
+}
 
-	}//: if !null
 
-	// Swap buffers.
-	glutSwapBuffers();
+void WindowProbability::drawLabels() {
+	float scale_x = (float)viewport_width/(float)(selected.size());
+	float scale_y = (float)viewport_height * 0.97;
 
-	// End of critical section.
+	// Convert indices to strings only once.
+	size_t max_index = *std::max_element(selected.begin(), selected.end());
+	while (labels.size() <= max_index)
+		labels.push_back(std::to_string(labels.size()));
+
+	// Skip labels if they would overlap (assuming ~6 pixels per character).
+	float label_width = 6.0f * (float)labels[max_index].size() + 4.0f;
+	size_t stride = std::max<size_t>(1, (size_t)std::ceil(label_width / scale_x));
+
+	for (size_t x = 0; x < selected.size(); x += stride)
+		draw_text(((float)x + 0.45f) * scale_x, scale_y, const_cast<char*>(labels[selected[x]].c_str()), 1.0f, 1.0f, 1.0f, 1.0f, GLUT_BITMAP_HELVETICA_10);
 }
 
-void WindowProbability::setMatrixPointer1(mic::types::MatrixXfPtr displayed_matrix_) {
+void WindowProbability::setMatrixPointer(size_t index_, mic::types::MatrixXfPtr displayed_matrix_) {
 	// Enter critical section.
 	APP_DATA_SYNCHRONIZATION_SCOPED_LOCK();
 
-	displayed_matrix1 = displayed_matrix_;
+	if (displayed_matrices.size() <= index_)
+		displayed_matrices.resize(index_ + 1);
+	displayed_matrices[index_] = displayed_matrix_;
 	// End of critical section.
 }
 
-void WindowProbability::setMatrixPointer2(mic::types::MatrixXfPtr displayed_matrix_) {
+void WindowProbability::setMatrixPointers(const std::vector<mic::types::MatrixXfPtr> & displayed_matrices_) {
 	// Enter critical section.
 	APP_DATA_SYNCHRONIZATION_SCOPED_LOCK();
 
-	displayed_matrix2 = displayed_matrix_;
+	displayed_matrices = displayed_matrices_;
 	// End of critical section.
 }
 
+void WindowProbability::setMatrixPointer1(mic::types::MatrixXfPtr displayed_matrix_) {
+	setMatrixPointer(0, displayed_matrix_);
+}
+
+void WindowProbability::setMatrixPointer2(mic::types::MatrixXfPtr displayed_matrix_) {
+	setMatrixPointer(1, displayed_matrix_);
+}
+
 } /* namespace visualization */
 } /* namespace opengl */
 } /* namespace mic */
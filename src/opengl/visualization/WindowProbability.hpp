@@ -27,6 +27,10 @@
 
 #include <opengl/visualization/Window.hpp>
 
+#include <stdint.h>
+#include <string>
+#include <vector>
+
 // Dependencies on core types.
 #include <types/MatrixTypes.hpp>
 using namespace mic::types;
@@ -36,7 +40,10 @@ namespace opengl {
 namespace visualization {
 
 /*!
- * \brief
+ * \brief OpenGL-based window displaying any number of overlaid probability distributions (e.g. target, prediction, ensemble members) as bar charts.
+ *
+ * In the top-K mode (off by default, enabled by setTopK() or the 'k' key) only K elements with the highest probabilities are displayed, in descending order - they are found by partial selection, so large distributions (e.g. thousands of classes) are handled in linear time.
+ * Bars of all distributions are collected into a single vertex array (coloured from a palette) and drawn with a single call, labels are cached.
  * \author tkornuta
  */
 class WindowProbability: public Window {
@@ -59,6 +66,30 @@ public:
 	 */
 	void displayHandler(void);
 
+	/*!
+	 * Toggles the top-K mode.
+	 */
+	void keyhandlerToggleTopK(void);
+
+	/*!
+	 * Sets number of elements displayed in the top-K mode and enables the mode.
+	 * @param top_k_ Number of elements.
+	 */
+	void setTopK(size_t top_k_);
+
+	/*!
+	 * Sets pointer to a displayed matrix with probability distribution.
+	 * @param index_ Index of the distribution (the list of distributions is extended if required).
+	 * @param displayed_matrix_ Pointer to the matrix (vector).
+	 */
+	void setMatrixPointer(size_t index_, mic::types::MatrixXfPtr displayed_matrix_);
+
+	/*!
+	 * Sets pointers to all displayed matrices with probability distributions.
+	 * @param displayed_matrices_ Vector of pointers to matrices (vectors).
+	 */
+	void setMatrixPointers(const std::vector<mic::types::MatrixXfPtr> & displayed_matrices_);
+
 	/*!
 	 * Sets pointer to first displayed matrix with probability distribution.
 	 * @param displayed_matrix_
@@ -74,14 +105,49 @@ public:
 private:
 
 	/*!
-	 * Pointer to first displayed matrix with probabilities.
+	 * Selects elements to be displayed - all of them or top-K (sorted in descending order of the max probability over the distributions).
+	 * @param elements_ Number of elements (of the longest distribution).
 	 */
-	mic::types::MatrixXfPtr displayed_matrix1;
+	void selectElements(size_t elements_);
 
 	/*!
-	 * Pointer to second displayed matrix with probabilities.
+	 * Returns the max probability of a given element over the displayed distributions.
+	 * @param index_ Index of the element.
 	 */
-	mic::types::MatrixXfPtr displayed_matrix2;
+	float score(size_t index_) const;
+
+	/*!
+	 * Draws bars of selected elements of all distributions with a single call.
+	 */
+	void drawBars();
+
+	/*!
+	 * Draws (cached) labels of selected elements, skipping some of them if they do not fit.
+	 */
+	void drawLabels();
+
+	/*!
+	 * Pointers to displayed matrices with probabilities.
+	 */
+	std::vector<mic::types::MatrixXfPtr> displayed_matrices;
+
+	/// Flag indicating whether only the top-K elements are displayed.
+	bool top_k_mode;
+
+	/// Number of elements displayed in the top-K mode.
+	size_t top_k;
+
+	/// Indices of displayed elements.
+	std::vector<size_t> selected;
+
+	/// Cached labels (indices of elements converted to strings).
+	std::vector<std::string> labels;
+
+	/// Vertices of bars (reused between frames).
+	std::vector<float> bar_vertices;
+
+	/// Colours of vertices of bars (packed RGBA8).
+	std::vector<uint32_t> bar_colors;
 };
 
 } /* namespace visualization */
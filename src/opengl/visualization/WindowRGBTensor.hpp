@@ -27,10 +27,20 @@
 
 #include <opengl/visualization/Window.hpp>
 #include <opengl/visualization/WindowManager.hpp>
+#include <opengl/visualization/NormalizationShader.hpp>
+#include <opengl/visualization/Texture2D.hpp>
+#include <opengl/visualization/WorkerPool.hpp>
+#include <opengl/visualization/FramePipeline.hpp>
 
 // Dependencies on core types.
 #include <types/TensorTypes.hpp>
 
+#include <Eigen/Core>
+#include <boost/bind.hpp>
+#include <algorithm>
+#include <cstring>
+#include <stdint.h>
+
 namespace mic {
 namespace opengl {
 namespace visualization {
@@ -48,7 +58,8 @@ public:
 	enum ChannelDisplay {
 		Chan_SeparateColor, //< Displays separate channels, colored according to the channel type (R/G/B)
 		Chan_SeparateGrayscale, //< Displays separate channels, all in grayscale.
-		Chan_RGB //< Displays RGB image.
+		Chan_RGB, //< Displays RGB image.
+		Chan_FeatureMaps //< Displays all channels (of tensors of arbitrary depth) as mosaics of grayscale feature maps.
 	};
 
 	/*!
@@ -63,6 +74,8 @@ public:
 			return "Displays separate channels, all in grayscale";
 		case(Chan_RGB):
 			return "Displays RGB image";
+		case(Chan_FeatureMaps):
+			return "Displays all channels as mosaics of grayscale feature maps";
 		}
 		return "UNDEFINED";
 	}
@@ -71,8 +84,9 @@ public:
 	 * Normalization of the RGB (three channel) images.
 	 */
 	enum Normalization {
-		Norm_None //< Displays original image(s), without any normalization (negative values simply won't be visible).
-		//Norm_Positive //< Displays image(s) with channels normalized to <0,1>.
+		Norm_None, //< Displays original image(s), without any normalization (negative values simply won't be visible).
+		Norm_Channel, //< Displays image(s) with every channel normalized separately to <0,1>.
+		Norm_Global //< Displays image(s) with all channels of a given image normalized together to <0,1>.
 	};
 
 	/*!
@@ -83,6 +97,10 @@ public:
 		switch(norm_) {
 		case(Norm_None):
 			return "Display original image(s), without any normalization";
+		case(Norm_Channel):
+			return "Display image(s) with every channel normalized separately to <0,1>";
+		case(Norm_Global):
+			return "Display image(s) with all channels of a given image normalized together to <0,1>";
 		}
 		return "UNDEFINED";
 	}
@@ -136,11 +154,23 @@ public:
 		Window(name_, position_x_, position_y_, width_, height_),
 		channel_display(channel_display_),
 		normalization(normalization_ ),
-		grid(grid_)
+		grid(grid_),
+		batch_published(false),
+		displayed_feature_maps(false),
+		displayed_samples(0),
+		displayed_batch_width(0),
+		displayed_batch_height(0),
+		layout(),
+		page(0),
+		max_texture_size(0),
+		oversized_reported(false),
+		pipeline(boost::bind(&WindowRGBTensor<eT>::prepareFrame, this, _1))
 	{
 		// Register additional key handler.
 		REGISTER_KEY_HANDLER('c', "c - toggles channel display mode", &WindowRGBTensor<eT>::keyhandlerToggleChannelDisplayMode);
 		REGISTER_KEY_HANDLER('g', "g - toggles grid mode", &WindowRGBTensor<eT>::keyhandlerGridMode);
+		REGISTER_KEY_HANDLER('n', "n - toggles normalization mode", &WindowRGBTensor<eT>::keyhandlerToggleNormalizationMode);
+		REGISTER_KEY_HANDLER('p', "p - displays next page of samples or feature maps", &WindowRGBTensor<eT>::keyhandlerNextPage);
 
 	}
 
@@ -155,11 +185,38 @@ public:
 	void keyhandlerToggleChannelDisplayMode(void) {
 		// Enter critical section.
 		APP_DATA_SYNCHRONIZATION_SCOPED_LOCK();
-		channel_display = (ChannelDisplay)((channel_display + 1) % 3);
+		channel_display = (ChannelDisplay)((channel_display + 1) % 4);
+		// Texture must be rebuilt.
+		batch_published = true;
 		LOG(LINFO) << chan2str(channel_display);
 		// End of critical section.
 	}
 
+	/*!
+	 * Changes normalization mode.
+	 */
+	void keyhandlerToggleNormalizationMode(void) {
+		// Enter critical section.
+		APP_DATA_SYNCHRONIZATION_SCOPED_LOCK();
+		normalization = (Normalization)((normalization + 1) % 3);
+		// Texture must be rebuilt.
+		batch_published = true;
+		LOG(LINFO) << norm2str(normalization);
+		// End of critical section.
+	}
+
+	/*!
+	 * Displays next page of samples or feature maps (used when the batch or mosaics do not fit into a single texture).
+	 */
+	void keyhandlerNextPage(void) {
+		// Enter critical section.
+		APP_DATA_SYNCHRONIZATION_SCOPED_LOCK();
+		page++;
+		// Texture must be rebuilt.
+		batch_published = true;
+		// End of critical section.
+	}
+
 	/*!
 	 * Changes grid visualization mode.
 	 */
@@ -184,21 +241,41 @@ public:
 		glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
 		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
-		// Draw batch - vector of 2d matrices.
-		if (batch_data.size() > 0){
+		// Draw all channels as feature maps.
+		if ((batch_data.size() > 0) && (channel_display == ChannelDisplay::Chan_FeatureMaps)) {
+			// Textures are prepared in the background once per publication.
+			if (batch_published)
+				submitFrame();
+			std::shared_ptr<Frame> frame = pipeline.takePrepared();
+			if (frame != nullptr)
+				uploadFrame(*frame);
+			drawFeatureMaps();
+		// Draw batch - vector of 3d tensors.
+		} else if (batch_data.size() > 0){
 			// Calculate batch "dimensions".
 			size_t batch_width = ceil(sqrt(batch_data.size()));
 			size_t batch_height = ceil((eT)batch_data.size()/batch_width);
 
-			// Tensor dimensions.
-			size_t height;
-			size_t width;
+			// Tensor dimensions (the whole batch is displayed using the size of the first sample).
+			size_t height = batch_data[0]->dim(0);
+			size_t width = batch_data[0]->dim(1);
 			size_t depth;
 
 			// Opengl scale.
 	    	eT scale_x, scale_y;
 
-	    	// Iterate through batch elements.
+			// Channels are composed from a single texture at draw time - displaying channels in grayscale requires a shader.
+			bool textured = (channel_display != ChannelDisplay::Chan_SeparateGrayscale) || shader.build();
+			if (textured) {
+				// Textures are prepared in the background once per publication.
+				if (batch_published)
+					submitFrame();
+				std::shared_ptr<Frame> frame = pipeline.takePrepared();
+				if (frame != nullptr)
+					uploadFrame(*frame);
+				drawBatchTextured();
+			} else
+	    	// Fall back to drawing batch elements one by one.
 			for (size_t by=0; by < batch_height; by++)
 				for (size_t bx=0; bx < batch_width; bx++) {
 					// Check if we do not excess size.
@@ -219,8 +296,8 @@ public:
 					case ChannelDisplay::Chan_SeparateColor:
 
 						// Calculate scale.
-				    	scale_x = (eT)glutGet(GLUT_WINDOW_WIDTH)/(eT)(width * batch_width * 3);
-				    	scale_y = (eT)glutGet(GLUT_WINDOW_HEIGHT)/(eT)(height * batch_height);
+				    	scale_x = (eT)viewport_width/(eT)(width * batch_width * 3);
+				    	scale_y = (eT)viewport_height/(eT)(height * batch_height);
 
 					   	// Iterate through matrix elements.
 						for (size_t y = 0; y < height; y++) {
@@ -259,8 +336,8 @@ public:
 					case ChannelDisplay::Chan_SeparateGrayscale:
 
 						// Calculate scale.
-				    	scale_x = (eT)glutGet(GLUT_WINDOW_WIDTH)/(eT)(width * batch_width * 3);
-				    	scale_y = (eT)glutGet(GLUT_WINDOW_HEIGHT)/(eT)(height * batch_height);
+				    	scale_x = (eT)viewport_width/(eT)(width * batch_width * 3);
+				    	scale_y = (eT)viewport_height/(eT)(height * batch_height);
 
 					   	// Iterate through matrix elements.
 						for (size_t y = 0; y < height; y++) {
@@ -299,8 +376,8 @@ public:
 					case ChannelDisplay::Chan_RGB:
 					default:
 						// Calculate scale.
-				    	scale_x = (eT)glutGet(GLUT_WINDOW_WIDTH)/(eT)(width * batch_width);
-				    	scale_y = (eT)glutGet(GLUT_WINDOW_HEIGHT)/(eT)(height * batch_height);
+				    	scale_x = (eT)viewport_width/(eT)(width * batch_width);
+				    	scale_y = (eT)viewport_height/(eT)(height * batch_height);
 
 				    	// Iterate through matrix elements.
 						for (size_t y = 0; y < height; y++) {
@@ -381,6 +458,7 @@ public:
 		batch_data.clear();
 		// Add sample.
 		batch_data.push_back(sample_ptr_);
+		batch_published = true;
 
 		// End of critical section.
 	}
@@ -394,6 +472,7 @@ public:
 		batch_data.clear();
 		// Add sample.
 		batch_data.push_back(sample_ptr_);
+		batch_published = true;
 	}
 
 	/*!
@@ -405,6 +484,7 @@ public:
 		APP_DATA_SYNCHRONIZATION_SCOPED_LOCK();
 
 		batch_data = batch_data_;
+		batch_published = true;
 
 		// End of critical section.
 	}
@@ -415,11 +495,483 @@ public:
 	 */
 	void setBatchUnsynchronized(std::vector <mic::types::TensorPtr<eT> > & batch_data_) {
 		batch_data = batch_data_;
+		batch_published = true;
 	}
 
 
 private:
 
+	/*!
+	 * \brief Structure describing the displayed page of feature maps (or samples in RGB modes, with a single tile per sample).
+	 */
+	struct FeatureMapLayout {
+		/// Number of columns of feature maps in a mosaic.
+		size_t tiles_x;
+
+		/// Number of rows of feature maps in a mosaic.
+		size_t tiles_y;
+
+		/// Number of columns of mosaics.
+		size_t samples_x;
+
+		/// Number of rows of mosaics.
+		size_t samples_y;
+
+		/// Range of displayed samples.
+		size_t first_sample, last_sample;
+
+		/// Range of displayed channels.
+		size_t first_channel, last_channel;
+
+		/// Index of the displayed page and number of pages.
+		size_t page, pages;
+	};
+
+	/*!
+	 * \brief Structure representing a frame passing through the pipeline - snapshot of the published batch and the texture prepared from it.
+	 */
+	struct Frame {
+		/// Channel display mode at the moment of publication.
+		ChannelDisplay channel_display;
+
+		/// Normalization mode at the moment of publication.
+		Normalization normalization;
+
+		/// Index of the page of samples or feature maps.
+		size_t page;
+
+		/// Max size of the texture.
+		size_t max_texture_size;
+
+		/// Size of samples.
+		size_t height, width, depth;
+
+		/// Snapshot of samples (empty if the size of a sample differs from the size of the first one).
+		std::vector<std::vector<eT> > samples;
+
+		/// Number of columns of the batch grid (RGB modes).
+		size_t batch_width;
+
+		/// Number of rows of the batch grid (RGB modes).
+		size_t batch_height;
+
+		/// Layout of the displayed page (feature maps or samples).
+		FeatureMapLayout layout;
+
+		/// Width of the prepared texture.
+		size_t texture_width;
+
+		/// Height of the prepared texture.
+		size_t texture_height;
+
+		/// Prepared pixels (RGB8 or 8-bit luminance in the feature maps mode).
+		std::vector<uint8_t> pixels;
+	};
+
+	/*!
+	 * Takes snapshot of the published batch and submits it to the pipeline (GL thread, inside of the critical section).
+	 */
+	void submitFrame() {
+		if (max_texture_size == 0)
+			glGetIntegerv(GL_MAX_TEXTURE_SIZE, &max_texture_size);
+
+		std::shared_ptr<Frame> frame = std::make_shared<Frame>();
+		frame->channel_display = channel_display;
+		frame->normalization = normalization;
+		frame->page = page;
+		frame->max_texture_size = (size_t)max_texture_size;
+		frame->height = batch_data[0]->dim(0);
+		frame->width = batch_data[0]->dim(1);
+		frame->depth = batch_data[0]->dim(2);
+		frame->samples.resize(batch_data.size());
+		for (size_t i=0; i < batch_data.size(); i++) {
+			// Skip samples of different size - RGB modes require only the first three channels.
+			if ((batch_data[i]->dim(0) != frame->height) || (batch_data[i]->dim(1) != frame->width) ||
+					((channel_display == ChannelDisplay::Chan_FeatureMaps) ? (batch_data[i]->dim(2) != frame->depth) : (batch_data[i]->dim(2) < 3))) {
+				LOG(LWARNING) << "Skipping sample " << i << " - its size differs from the size of the first sample";
+				continue;
+			}//: if
+			const eT* data_ptr = batch_data[i]->data();
+			frame->samples[i].assign(data_ptr, data_ptr + frame->height * frame->width * batch_data[i]->dim(2));
+		}//: for
+		pipeline.submit(frame);
+		batch_published = false;
+	}
+
+	/*!
+	 * Prepares texture of the frame (pipeline thread).
+	 * @param frame_ Frame.
+	 */
+	void prepareFrame(Frame & frame_) {
+		if (frame_.channel_display == ChannelDisplay::Chan_FeatureMaps)
+			prepareFeatureMaps(frame_);
+		else
+			prepareBatch(frame_);
+	}
+
+	/*!
+	 * Uploads the prepared texture and makes it the displayed one (GL thread).
+	 * @param frame_ Prepared frame.
+	 */
+	void uploadFrame(const Frame & frame_) {
+		displayed_feature_maps = (frame_.channel_display == ChannelDisplay::Chan_FeatureMaps);
+		// Report the displayed page only when it changes (not on every publication).
+		const FeatureMapLayout& next = frame_.layout;
+		if ((next.pages > 1) && ((next.page != layout.page) || (next.pages != layout.pages))) {
+			if (displayed_feature_maps)
+				LOG(LINFO) << "Displaying page " << next.page + 1 << " of " << next.pages << " (samples " << next.first_sample
+					<< "-" << next.last_sample - 1 << ", channels " << next.first_channel << "-" << next.last_channel - 1 << ")";
+			else
+				LOG(LINFO) << "Displaying page " << next.page + 1 << " of " << next.pages << " (samples " << next.first_sample
+					<< "-" << next.last_sample - 1 << ")";
+		}//: if
+		displayed_samples = next.last_sample - next.first_sample;
+		displayed_batch_width = frame_.batch_width;
+		displayed_batch_height = frame_.batch_height;
+		layout = frame_.layout;
+		if (frame_.pixels.empty())
+			return;
+		if (displayed_feature_maps)
+			atlas.uploadLuminance(frame_.texture_width, frame_.texture_height, frame_.pixels.data());
+		else
+			atlas.uploadRGB(frame_.texture_width, frame_.texture_height, frame_.pixels.data());
+	}
+
+	/*!
+	 * Computes range of values of a given channel that will be mapped to <0,1> according to the normalization mode.
+	 * @param normalization_ Normalization mode.
+	 * @param plane_ Pointer to the channel.
+	 * @param plane_size_ Number of elements of the channel.
+	 * @param global_min_ Min value of all channels of the sample (used in Norm_Global).
+	 * @param global_max_ Max value of all channels of the sample (used in Norm_Global).
+	 * @param min_ Returned min value.
+	 * @param max_ Returned max value.
+	 */
+	static void channelRange(Normalization normalization_, const eT* plane_, size_t plane_size_, float global_min_, float global_max_, float & min_, float & max_) {
+		switch(normalization_) {
+		case Normalization::Norm_Channel: {
+			Eigen::Map<const Eigen::Array<eT, Eigen::Dynamic, 1> > plane(plane_, plane_size_);
+			min_ = (float)plane.minCoeff();
+			max_ = (float)plane.maxCoeff();
+			break;
+		}
+		case Normalization::Norm_Global:
+			min_ = global_min_;
+			max_ = global_max_;
+			break;
+		// None is default.
+		case Normalization::Norm_None:
+		default:
+			min_ = 0.0f;
+			max_ = 1.0f;
+			break;
+		}//: switch
+	}
+
+	/*!
+	 * Computes min and max values of all channels of a sample - only if required by the normalization mode.
+	 * @param normalization_ Normalization mode.
+	 * @param sample_ Sample.
+	 * @param min_ Returned min value.
+	 * @param max_ Returned max value.
+	 */
+	static void sampleRange(Normalization normalization_, const std::vector<eT> & sample_, float & min_, float & max_) {
+		min_ = 0.0f;
+		max_ = 1.0f;
+		if ((normalization_ == Normalization::Norm_Global) && !sample_.empty()) {
+			Eigen::Map<const Eigen::Array<eT, Eigen::Dynamic, 1> > sample(sample_.data(), sample_.size());
+			min_ = (float)sample.minCoeff();
+			max_ = (float)sample.maxCoeff();
+		}//: if
+	}
+
+	/*!
+	 * Maps values from <min,max> to <0,255> in a single vectorized pass (values outside of the range are clamped).
+	 * @param plane_ Pointer to the values.
+	 * @param plane_size_ Number of values.
+	 * @param min_ Value mapped to 0.
+	 * @param max_ Value mapped to 255.
+	 * @param quantized_ Returned quantized values.
+	 */
+	static void quantize(const eT* plane_, size_t plane_size_, float min_, float max_, Eigen::Array<uint8_t, Eigen::Dynamic, 1> & quantized_) {
+		Eigen::Map<const Eigen::Array<eT, Eigen::Dynamic, 1> > plane(plane_, plane_size_);
+		// All values equal - display black.
+		float scale = (max_ > min_) ? 255.0f / (max_ - min_) : 0.0f;
+		quantized_ = ((plane.template cast<float>() - min_) * scale).max(0.0f).min(255.0f).template cast<uint8_t>();
+	}
+
+	/*!
+	 * Converts the first three (planar) channels of a sample to interleaved RGB8.
+	 * Every plane is normalized and quantized in a single vectorized pass, then its rows are scattered to the interleaved output.
+	 * @param normalization_ Normalization mode.
+	 * @param sample_ Planar data of the sample.
+	 * @param height_ Height of the sample.
+	 * @param width_ Width of the sample.
+	 * @param rgb_ptr_ Pointer to the first pixel of the sample in the output.
+	 * @param row_stride_ Distance (in bytes) between consecutive rows of the output.
+	 */
+	static void deinterleave(Normalization normalization_, const std::vector<eT> & sample_, size_t height_, size_t width_, uint8_t* rgb_ptr_, size_t row_stride_) {
+		typedef Eigen::Map<Eigen::Array<uint8_t, Eigen::Dynamic, 1>, 0, Eigen::InnerStride<3> > InterleavedRowType;
+
+		size_t plane_size = height_ * width_;
+		float global_min, global_max;
+		sampleRange(normalization_, sample_, global_min, global_max);
+		Eigen::Array<uint8_t, Eigen::Dynamic, 1> quantized;
+		for (size_t c = 0; c < 3; c++) {
+			// Normalize and quantize the whole plane.
+			float min, max;
+			const eT* plane = sample_.data() + c * plane_size;
+			channelRange(normalization_, plane, plane_size, global_min, global_max, min, max);
+			quantize(plane, plane_size, min, max, quantized);
+			// Scatter rows.
+			for (size_t y = 0; y < height_; y++) {
+				InterleavedRowType row(rgb_ptr_ + y * row_stride_ + c, width_);
+				row = quantized.segment(y * width_, width_);
+			}//: for
+		}//: for
+	}
+
+	/*!
+	 * Converts a range of samples of the displayed page to RGB8 and places them in the frame buffer.
+	 * Every sample is written to a separate cell, so ranges can be processed in parallel.
+	 * @param frame_ Frame.
+	 * @param first_ Index of the first sample (counting samples of the page).
+	 * @param last_ Index of the sample after the last one.
+	 */
+	static void packSamples(Frame & frame_, size_t first_, size_t last_) {
+		for (size_t i = first_; i < last_; i++) {
+			const std::vector<eT> & sample = frame_.samples[frame_.layout.first_sample + i];
+			// Skipped sample.
+			if (sample.empty())
+				continue;
+			size_t bx = i % frame_.batch_width;
+			size_t by = i / frame_.batch_width;
+			deinterleave(frame_.normalization, sample, frame_.height, frame_.width,
+					&frame_.pixels[(by * frame_.height * frame_.texture_width + bx * frame_.width) * 3], frame_.texture_width * 3);
+		}//: for
+	}
+
+	/*!
+	 * Computes layout of samples of the frame (RGB modes), limited by the max texture size - batch grid that does not fit into a single texture is split into pages.
+	 * @param frame_ Frame.
+	 */
+	static void computeBatchLayout(Frame & frame_) {
+		FeatureMapLayout& layout = frame_.layout;
+		size_t max_size = frame_.max_texture_size;
+
+		// Every sample is a single tile with three channels.
+		layout.tiles_x = layout.tiles_y = 1;
+		layout.first_channel = 0;
+		layout.last_channel = 3;
+
+		// Arrange samples in the batch grid.
+		size_t batch_width = ceil(sqrt(frame_.samples.size()));
+		size_t batch_height = ceil((float)frame_.samples.size()/batch_width);
+		layout.samples_x = std::min(batch_width, std::max<size_t>(max_size / frame_.width, 1));
+		layout.samples_y = std::min(batch_height, std::max<size_t>(max_size / frame_.height, 1));
+		size_t samples_per_page = layout.samples_x * layout.samples_y;
+
+		// Select the displayed page.
+		layout.pages = (frame_.samples.size() + samples_per_page - 1) / samples_per_page;
+		layout.page = frame_.page % layout.pages;
+		layout.first_sample = layout.page * samples_per_page;
+		layout.last_sample = std::min(layout.first_sample + samples_per_page, frame_.samples.size());
+	}
+
+	/*!
+	 * Converts samples of the displayed page to RGB8, placed in the same grid as they are displayed (so the whole page is a single texture).
+	 * @param frame_ Frame.
+	 */
+	void prepareBatch(Frame & frame_) {
+		// A single sample that does not fit into the texture cannot be displayed.
+		if ((frame_.width > frame_.max_texture_size) || (frame_.height > frame_.max_texture_size)) {
+			if (!oversized_reported)
+				LOG(LERROR) << "Cannot display batch - size of a sample (" << frame_.width << "x" << frame_.height << ") exceeds the max texture size (" << frame_.max_texture_size << ")";
+			oversized_reported = true;
+			frame_.layout = FeatureMapLayout();
+			return;
+		}//: if
+		oversized_reported = false;
+
+		computeBatchLayout(frame_);
+		frame_.batch_width = frame_.layout.samples_x;
+		frame_.batch_height = frame_.layout.samples_y;
+		frame_.texture_width = frame_.batch_width * frame_.width;
+		frame_.texture_height = frame_.batch_height * frame_.height;
+		// Empty cells remain black.
+		frame_.pixels.assign(frame_.texture_width * frame_.texture_height * 3, 0);
+		// Convert samples in parallel.
+		VGL_WORKER_POOL->parallelFor(0, frame_.layout.last_sample - frame_.layout.first_sample, std::max<size_t>(1, WorkerPool::min_elements_per_task / (3 * frame_.height * frame_.width)),
+				boost::bind(&WindowRGBTensor<eT>::packSamples, boost::ref(frame_), _1, _2));
+	}
+
+	/*!
+	 * Draws the batch from the texture, composing channels according to the channel display mode.
+	 */
+	void drawBatchTextured() {
+		// Texture is not ready yet (or the batch cannot be displayed).
+		if (displayed_feature_maps || (displayed_samples == 0) || !atlas.isAllocated())
+			return;
+
+		atlas.bind();
+		if (channel_display == ChannelDisplay::Chan_RGB) {
+			// Texture layout matches the batch grid - a single quad.
+			glEnable(GL_TEXTURE_2D);
+			glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_REPLACE);
+			atlas.draw(0.0f, 0.0f, (float)viewport_height, (float)viewport_width);
+			glDisable(GL_TEXTURE_2D);
+		} else {
+			// Draw channels one next to another.
+			float scale_x = (float)viewport_width/(float)(displayed_batch_width * 3);
+			float scale_y = (float)viewport_height/(float)(displayed_batch_height);
+			for (size_t c = 0; c < 3; c++) {
+				if (channel_display == ChannelDisplay::Chan_SeparateGrayscale) {
+					// Swizzle the channel in the shader.
+					shader.useChannel(c, 1.0f, 1.0f, 1.0f);
+				} else {
+					// Tint - the fixed pipeline multiplies the texture by the current colour.
+					glEnable(GL_TEXTURE_2D);
+					glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
+					glColor4f(c == 0, c == 1, c == 2, 1.0f);
+				}//: else
+
+				for (size_t i=0; i < displayed_samples; i++) {
+					size_t bx = i % displayed_batch_width;
+					size_t by = i / displayed_batch_width;
+					atlas.draw(float(3*bx+c) * scale_x, float(by) * scale_y, scale_y, scale_x,
+							float(bx)/displayed_batch_width, float(by)/displayed_batch_height, float(bx+1)/displayed_batch_width, float(by+1)/displayed_batch_height);
+				}//: for
+
+				if (channel_display == ChannelDisplay::Chan_SeparateGrayscale)
+					shader.release();
+				else
+					glDisable(GL_TEXTURE_2D);
+			}//: for
+		}//: else
+		atlas.unbind();
+	}
+
+	/*!
+	 * Computes layout of feature maps of the frame, limited by the max texture size.
+	 * Channels of a sample are arranged in a mosaic, mosaics are arranged in the batch grid - mosaics (or channels) that do not fit into a single texture are split into pages.
+	 * @param frame_ Frame.
+	 */
+	static void computeFeatureMapLayout(Frame & frame_) {
+		FeatureMapLayout& layout = frame_.layout;
+		size_t max_size = frame_.max_texture_size;
+
+		// Arrange channels in a square-ish mosaic.
+		layout.tiles_x = std::min((size_t)ceil(sqrt(frame_.depth)), std::max<size_t>(max_size / frame_.width, 1));
+		layout.tiles_y = std::min((size_t)ceil((float)frame_.depth / layout.tiles_x), std::max<size_t>(max_size / frame_.height, 1));
+		size_t channels_per_page = layout.tiles_x * layout.tiles_y;
+		size_t channel_pages = (frame_.depth + channels_per_page - 1) / channels_per_page;
+
+		// Arrange mosaics in the batch grid.
+		size_t mosaic_width = layout.tiles_x * frame_.width;
+		size_t mosaic_height = layout.tiles_y * frame_.height;
+		size_t batch_width = ceil(sqrt(frame_.samples.size()));
+		size_t batch_height = ceil((float)frame_.samples.size()/batch_width);
+		layout.samples_x = std::min(batch_width, std::max<size_t>(max_size / mosaic_width, 1));
+		layout.samples_y = std::min(batch_height, std::max<size_t>(max_size / mosaic_height, 1));
+		size_t samples_per_page = layout.samples_x * layout.samples_y;
+		size_t sample_pages = (frame_.samples.size() + samples_per_page - 1) / samples_per_page;
+
+		// Select the displayed page.
+		layout.pages = sample_pages * channel_pages;
+		layout.page = frame_.page % layout.pages;
+		layout.first_sample = (layout.page / channel_pages) * samples_per_page;
+		layout.last_sample = std::min(layout.first_sample + samples_per_page, frame_.samples.size());
+		layout.first_channel = (layout.page % channel_pages) * channels_per_page;
+		layout.last_channel = std::min(layout.first_channel + channels_per_page, frame_.depth);
+	}
+
+	/*!
+	 * Normalizes, quantizes and places a range of feature maps of the displayed page in the frame buffer.
+	 * Every feature map is written to a separate tile, so ranges can be processed in parallel.
+	 * @param frame_ Frame.
+	 * @param first_ Index of the first feature map (counting feature maps of all samples of the page).
+	 * @param last_ Index of the feature map after the last one.
+	 * @param sample_min_ Min values of samples (used in Norm_Global).
+	 * @param sample_max_ Max values of samples (used in Norm_Global).
+	 */
+	static void quantizeFeatureMaps(Frame & frame_, size_t first_, size_t last_, const std::vector<float> & sample_min_, const std::vector<float> & sample_max_) {
+		const FeatureMapLayout& layout = frame_.layout;
+		size_t channels = layout.last_channel - layout.first_channel;
+		size_t plane_size = frame_.height * frame_.width;
+		Eigen::Array<uint8_t, Eigen::Dynamic, 1> quantized;
+		for (size_t i = first_; i < last_; i++) {
+			size_t s = i / channels;
+			size_t c = i % channels;
+			const eT* plane = frame_.samples[layout.first_sample + s].data() + (layout.first_channel + c) * plane_size;
+
+			float min, max;
+			channelRange(frame_.normalization, plane, plane_size, sample_min_[s], sample_max_[s], min, max);
+			quantize(plane, plane_size, min, max, quantized);
+
+			// Position of the tile in the mosaic buffer.
+			size_t x = ((s % layout.samples_x) * layout.tiles_x + c % layout.tiles_x) * frame_.width;
+			size_t y = ((s / layout.samples_x) * layout.tiles_y + c / layout.tiles_x) * frame_.height;
+			for (size_t row = 0; row < frame_.height; row++)
+				memcpy(&frame_.pixels[(y + row) * frame_.texture_width + x], quantized.data() + row * frame_.width, frame_.width);
+		}//: for
+	}
+
+	/*!
+	 * Builds mosaics of feature maps of the displayed page as a single texture.
+	 * Feature maps are processed in parallel.
+	 * @param frame_ Frame.
+	 */
+	void prepareFeatureMaps(Frame & frame_) {
+		for (size_t i=0; i < frame_.samples.size(); i++) {
+			if (frame_.samples[i].empty()) {
+				LOG(LERROR) << "Cannot display feature maps - size of sample " << i << " differs from the size of the first sample";
+				frame_.layout = FeatureMapLayout();
+				return;
+			}//: if
+		}//: for
+		computeFeatureMapLayout(frame_);
+		const FeatureMapLayout& layout = frame_.layout;
+
+		// Empty tiles remain black.
+		frame_.texture_width = layout.samples_x * layout.tiles_x * frame_.width;
+		frame_.texture_height = layout.samples_y * layout.tiles_y * frame_.height;
+		frame_.pixels.assign(frame_.texture_width * frame_.texture_height, 0);
+
+		// Global ranges of samples.
+		size_t samples = layout.last_sample - layout.first_sample;
+		std::vector<float> sample_min(samples), sample_max(samples);
+		for (size_t s = 0; s < samples; s++)
+			sampleRange(frame_.normalization, frame_.samples[layout.first_sample + s], sample_min[s], sample_max[s]);
+
+		// Process feature maps in parallel.
+		size_t feature_maps = samples * (layout.last_channel - layout.first_channel);
+		VGL_WORKER_POOL->parallelFor(0, feature_maps, std::max<size_t>(1, WorkerPool::min_elements_per_task / (frame_.height * frame_.width)),
+				boost::bind(&WindowRGBTensor<eT>::quantizeFeatureMaps, boost::ref(frame_), _1, _2, boost::cref(sample_min), boost::cref(sample_max)));
+	}
+
+	/*!
+	 * Draws the displayed page of feature maps and the grids.
+	 */
+	void drawFeatureMaps() {
+		// Nothing to display (or texture is not ready yet).
+		if (!displayed_feature_maps || (layout.tiles_x == 0))
+			return;
+
+		// Texture layout matches the displayed grid - a single quad.
+		atlas.bind();
+		glEnable(GL_TEXTURE_2D);
+		glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_REPLACE);
+		atlas.draw(0.0f, 0.0f, (float)viewport_height, (float)viewport_width);
+		glDisable(GL_TEXTURE_2D);
+		atlas.unbind();
+
+		// Draw grids dividing the feature maps and samples.
+		if ((grid == Grid::Grid_Sample) || (grid == Grid::Grid_Both))
+			draw_grid(0.3f, 0.8f, 0.3f, 0.3f, layout.samples_x * layout.tiles_x, layout.samples_y * layout.tiles_y);
+		if ((grid == Grid::Grid_Batch) || (grid == Grid::Grid_Both))
+			draw_grid(0.3f, 0.8f, 0.3f, 0.3f, layout.samples_x, layout.samples_y, 4.0);
+	}
+
 	/*!
 	 * Pointer to displayed batch.
 	 */
@@ -433,6 +985,42 @@ private:
 
 	/// Grid display mode.
 	Grid grid;
+
+	/// Shader swizzling channels (used for displaying channels in grayscale).
+	NormalizationShader shader;
+
+	/// Texture storing the displayed frame (whole batch in RGB8 or mosaics of feature maps).
+	Texture2D atlas;
+
+	/// Flag indicating that a new batch was published and must be submitted to the pipeline.
+	bool batch_published;
+
+	/// Flag indicating that the texture stores feature maps.
+	bool displayed_feature_maps;
+
+	/// Number of samples in the texture.
+	size_t displayed_samples;
+
+	/// Number of columns of the batch grid in the texture.
+	size_t displayed_batch_width;
+
+	/// Number of rows of the batch grid in the texture.
+	size_t displayed_batch_height;
+
+	/// Layout of the displayed page of samples or feature maps.
+	FeatureMapLayout layout;
+
+	/// Index of the displayed page of samples or feature maps.
+	size_t page;
+
+	/// Max size of the texture supported by the implementation (queried on first use).
+	GLint max_texture_size;
+
+	/// Flag indicating that samples exceeding the max texture size were reported (used only by the pipeline thread, so the error is logged once).
+	bool oversized_reported;
+
+	/// Pipeline preparing textures in the background (declared last, so its thread stops before other members are destroyed).
+	FramePipeline<Frame> pipeline;
 };
 
 } /* namespace visualization */
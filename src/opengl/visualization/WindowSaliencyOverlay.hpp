@@ -0,0 +1,303 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file WindowSaliencyOverlay.hpp
+ * \brief Window displaying saliency (attention) map blended over a RGB image.
+ * \author tkornuta
+ * \date Oct 18, 2026
+ */
+
+#ifndef SRC_OPENGL_VISUALIZATION_WINDOWSALIENCYOVERLAY_HPP_
+#define SRC_OPENGL_VISUALIZATION_WINDOWSALIENCYOVERLAY_HPP_
+
+#include <opengl/visualization/Window.hpp>
+#include <opengl/visualization/WindowManager.hpp>
+#include <opengl/visualization/Colormap.hpp>
+#include <opengl/visualization/Texture2D.hpp>
+
+// Dependencies on core types.
+#include <types/MatrixTypes.hpp>
+#include <types/TensorTypes.hpp>
+
+#include <Eigen/Core>
+
+#include <algorithm>
+#include <cmath>
+#include <stdint.h>
+#include <vector>
+
+namespace mic {
+namespace opengl {
+namespace visualization {
+
+/*!
+ * \brief OpenGL-based window displaying saliency (attention) map as a semi-transparent, colormapped layer over a RGB image (3D tensor, as displayed by WindowRGBTensor).
+ *
+ * Image and saliency are stored in separate textures: the image is uploaded only when a new one is published, so per-step updates of saliency upload only the (usually small) saliency map.
+ * Saliency is resampled to the resolution of the image by linear filtering of its texture. Opacity of the overlay is proportional to the saliency, so non-salient regions leave the image visible.
+ * \author tkornuta
+ * \tparam eT Precision (float/double) (DEFAULT=float).
+ */
+template <typename eT = float>
+class WindowSaliencyOverlay: public Window {
+public:
+	/*!
+	 * Constructor.
+	 */
+	WindowSaliencyOverlay(std::string name_ = "WindowSaliencyOverlay",
+			unsigned int position_x_ = 0, unsigned int position_y_ = 0,
+			unsigned int width_ = 512, unsigned int height_ = 512) :
+		Window(name_, position_x_, position_y_, width_, height_),
+		colormap(Colormap_Magma),
+		opacity(0.7f),
+		overlay_visible(true),
+		image_published(false),
+		saliency_published(false)
+	{
+		saliency_texture.setFilter(GL_LINEAR);
+		// Register additional key handler.
+		REGISTER_KEY_HANDLER('m', "m - toggles colormap of the saliency", &WindowSaliencyOverlay<eT>::keyhandlerToggleColormap);
+		REGISTER_KEY_HANDLER('o', "o - shows/hides the saliency", &WindowSaliencyOverlay<eT>::keyhandlerToggleOverlay);
+	}
+
+	/*!
+	 * Virtual destructor - empty.
+	 */
+	virtual ~WindowSaliencyOverlay() { }
+
+	/*!
+	 * Changes colormap of the saliency.
+	 */
+	void keyhandlerToggleColormap(void) {
+		// Enter critical section.
+		APP_DATA_SYNCHRONIZATION_SCOPED_LOCK();
+		colormap.setType((ColormapType)((colormap.getType() + 1) % Colormap_Count));
+		// Saliency must be recoloured.
+		saliency_published = true;
+		LOG(LINFO) << Colormap::colormap2str(colormap.getType());
+		// End of critical section.
+	}
+
+	/*!
+	 * Shows/hides the saliency.
+	 */
+	void keyhandlerToggleOverlay(void) {
+		// Enter critical section.
+		APP_DATA_SYNCHRONIZATION_SCOPED_LOCK();
+		overlay_visible = !overlay_visible;
+		// End of critical section.
+	}
+
+	/*!
+	 * Sets max opacity of the saliency (reached by the most salient elements).
+	 * @param opacity_ Opacity (0-1).
+	 */
+	void setOpacity(float opacity_) {
+		// Enter critical section.
+		APP_DATA_SYNCHRONIZATION_SCOPED_LOCK();
+		opacity = opacity_;
+		// End of critical section.
+	}
+
+	/*!
+	 * Refreshes the content of the window.
+	 */
+	void displayHandler(void){
+		LOG(LTRACE) << "WindowSaliencyOverlay::Display handler of window " << glutGetWindow();
+		// Enter critical section.
+		APP_DATA_SYNCHRONIZATION_SCOPED_LOCK();
+
+		// Clear buffer.
+		glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+		// Upload only what has changed.
+		if (image_published)
+			uploadImage();
+		if (saliency_published)
+			uploadSaliency();
+
+		glEnable(GL_TEXTURE_2D);
+		// Draw image.
+		if (image_texture.isAllocated()) {
+			glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_REPLACE);
+			image_texture.bind();
+			image_texture.draw(0.0f, 0.0f, (float)viewport_height, (float)viewport_width);
+			image_texture.unbind();
+		}//: if
+
+		// Blend saliency - alpha of texels is scaled by the opacity.
+		if (overlay_visible && saliency_texture.isAllocated()) {
+			glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
+			glColor4f(1.0f, 1.0f, 1.0f, opacity);
+			saliency_texture.bind();
+			// Column-major matrix: texture is rows wide and cols high.
+			saliency_texture.draw(0.0f, 0.0f, (float)viewport_height, (float)viewport_width, 0.0f, 0.0f, 1.0f, 1.0f, true);
+			saliency_texture.unbind();
+		}//: if
+		glDisable(GL_TEXTURE_2D);
+
+		// Swap buffers.
+		glutSwapBuffers();
+
+		// End of critical section.
+	}
+
+	/*!
+	 * Sets displayed image and saliency.
+	 * @param image_ptr_ Pointer to the image (3D tensor: height x width x channels, first three channels are displayed).
+	 * @param saliency_ptr_ Pointer to the saliency (matrix of arbitrary size, resampled to the size of the image).
+	 */
+	void setDataPointersSynchronized(mic::types::TensorPtr<eT> image_ptr_, mic::types::MatrixPtr<eT> saliency_ptr_) {
+		// Enter critical section.
+		APP_DATA_SYNCHRONIZATION_SCOPED_LOCK();
+		setImagePointerUnsynchronized(image_ptr_);
+		setSaliencyPointerUnsynchronized(saliency_ptr_);
+		// End of critical section.
+	}
+
+	/*!
+	 * Sets displayed image.
+	 * @param image_ptr_ Pointer to the image (3D tensor: height x width x channels, first three channels are displayed).
+	 */
+	void setImagePointerSynchronized(mic::types::TensorPtr<eT> image_ptr_) {
+		// Enter critical section.
+		APP_DATA_SYNCHRONIZATION_SCOPED_LOCK();
+		setImagePointerUnsynchronized(image_ptr_);
+		// End of critical section.
+	}
+
+	/*!
+	 * Sets displayed image. Unsynchronized i.e. must be used inside of manually synchronized section.
+	 * @param image_ptr_ Pointer to the image (3D tensor: height x width x channels, first three channels are displayed).
+	 */
+	void setImagePointerUnsynchronized(mic::types::TensorPtr<eT> image_ptr_) {
+		image_ptr = image_ptr_;
+		image_published = true;
+	}
+
+	/*!
+	 * Sets displayed saliency - the image is not uploaded again.
+	 * @param saliency_ptr_ Pointer to the saliency (matrix of arbitrary size, resampled to the size of the image).
+	 */
+	void setSaliencyPointerSynchronized(mic::types::MatrixPtr<eT> saliency_ptr_) {
+		// Enter critical section.
+		APP_DATA_SYNCHRONIZATION_SCOPED_LOCK();
+		setSaliencyPointerUnsynchronized(saliency_ptr_);
+		// End of critical section.
+	}
+
+	/*!
+	 * Sets displayed saliency. Unsynchronized i.e. must be used inside of manually synchronized section.
+	 * @param saliency_ptr_ Pointer to the saliency (matrix of arbitrary size, resampled to the size of the image).
+	 */
+	void setSaliencyPointerUnsynchronized(mic::types::MatrixPtr<eT> saliency_ptr_) {
+		saliency_ptr = saliency_ptr_;
+		saliency_published = true;
+	}
+
+private:
+
+	/*!
+	 * Interleaves channels of the image and uploads it to the texture.
+	 */
+	void uploadImage() {
+		image_published = false;
+		if ((image_ptr == nullptr) || (image_ptr->dims().size() < 3) || (image_ptr->dim(2) < 3))
+			return;
+		size_t height = image_ptr->dim(0);
+		size_t width = image_ptr->dim(1);
+		size_t pixels = height * width;
+
+		// Channels are stored one after another - interleave them, clamping values to <0,1> (vectorized by Eigen).
+		rgb.resize(3 * pixels);
+		for (size_t c = 0; c < 3; c++) {
+			Eigen::Map<const Eigen::Array<eT, Eigen::Dynamic, 1> > channel(image_ptr->data() + c * pixels, pixels);
+			Eigen::Map<Eigen::Array<uint8_t, Eigen::Dynamic, 1>, 0, Eigen::InnerStride<3> > interleaved(rgb.data() + c, pixels);
+			interleaved = (channel.template cast<float>().max(0.0f).min(1.0f) * 255.0f + 0.5f).template cast<uint8_t>();
+		}//: for
+		image_texture.uploadRGB(width, height, rgb.data());
+	}
+
+	/*!
+	 * Colours the saliency, sets opacity of elements and uploads it to the texture.
+	 */
+	void uploadSaliency() {
+		saliency_published = false;
+		if ((saliency_ptr == nullptr) || (saliency_ptr->size() == 0))
+			return;
+		size_t size = saliency_ptr->size();
+		Eigen::Map<const Eigen::Array<eT, Eigen::Dynamic, 1> > values(saliency_ptr->data(), size);
+		eT min = values.minCoeff();
+		eT max = values.maxCoeff();
+
+		rgba.resize(size);
+		colormap.apply(saliency_ptr->data(), size, min, max, rgba.data());
+
+		// Opacity proportional to the saliency (for diverging colormap - to its magnitude).
+		Eigen::Map<Eigen::Array<uint8_t, Eigen::Dynamic, 1>, 0, Eigen::InnerStride<4> > alpha(reinterpret_cast<uint8_t*>(rgba.data()) + 3, size);
+		if (colormap.getType() == Colormap_Diverging) {
+			float range = (float)std::max(std::abs(min), std::abs(max));
+			float scale = (range > 0.0f) ? 255.0f / range : 0.0f;
+			alpha = (values.template cast<float>().abs() * scale + 0.5f).template cast<uint8_t>();
+		} else {
+			float scale = (max > min) ? 255.0f / (float)(max - min) : 0.0f;
+			alpha = ((values.template cast<float>() - (float)min) * scale + 0.5f).template cast<uint8_t>();
+		}//: else
+
+		// Column-major matrix: texture is rows wide and cols high.
+		saliency_texture.uploadRGBA(saliency_ptr->rows(), saliency_ptr->cols(), rgba.data());
+	}
+
+	/// Pointer to displayed image.
+	mic::types::TensorPtr<eT> image_ptr;
+
+	/// Pointer to displayed saliency.
+	mic::types::MatrixPtr<eT> saliency_ptr;
+
+	/// Colormap of the saliency.
+	Colormap colormap;
+
+	/// Max opacity of the saliency.
+	float opacity;
+
+	/// Flag indicating whether the saliency is displayed.
+	bool overlay_visible;
+
+	/// Texture storing the image (interleaved RGB).
+	Texture2D image_texture;
+
+	/// Texture storing the coloured saliency (linearly filtered).
+	Texture2D saliency_texture;
+
+	/// Buffer storing the interleaved image.
+	std::vector<uint8_t> rgb;
+
+	/// Buffer storing colours of the saliency.
+	std::vector<uint32_t> rgba;
+
+	/// Flag indicating that a new image was published and must be uploaded.
+	bool image_published;
+
+	/// Flag indicating that a new saliency was published and must be uploaded.
+	bool saliency_published;
+};
+
+} /* namespace visualization */
+} /* namespace opengl */
+} /* namespace mic */
+
+#endif /* SRC_OPENGL_VISUALIZATION_WINDOWSALIENCYOVERLAY_HPP_ */
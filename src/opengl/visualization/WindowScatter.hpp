@@ -0,0 +1,602 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file WindowScatter.hpp
+ * \brief Window displaying 2D points (e.g. embeddings produced by t-SNE/UMAP/PCA), coloured by labels.
+ * \author tkornuta
+ * \date Oct 18, 2026
+ */
+
+#ifndef SRC_OPENGL_VISUALIZATION_WINDOWSCATTER_HPP_
+#define SRC_OPENGL_VISUALIZATION_WINDOWSCATTER_HPP_
+
+#include <opengl/visualization/Window.hpp>
+#include <opengl/visualization/WindowManager.hpp>
+#include <opengl/visualization/Colormap.hpp>
+#include <opengl/visualization/Texture2D.hpp>
+
+// Dependencies on core types.
+#include <types/MatrixTypes.hpp>
+
+#include <Eigen/Core>
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <sstream>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace mic {
+namespace opengl {
+namespace visualization {
+
+/*!
+ * \brief Enumerator defining how points are displayed.
+ * \author tkornuta
+ */
+enum ScatterMode {
+	Scatter_Auto = 0, ///< Points, switching to density when there are more points than pixels
+	Scatter_Points, ///< Every point is drawn
+	Scatter_Density, ///< Number of points falling into every pixel is displayed (log scale)
+	Scatter_Count ///< Number of modes (used for toggling)
+};
+
+/*!
+ * \brief OpenGL-based window displaying large sets of 2D points (e.g. embeddings), coloured by labels.
+ *
+ * Points are uploaded to a vertex buffer object once per publication and drawn with a single call, scaled to the chart with the modelview transformation.
+ * When there are more points than pixels, the window switches to the density mode - points are binned into pixels and the (log) counts are displayed as a texture.
+ * Points are indexed with a uniform grid, so the point nearest to the mouse pointer is found by visiting a few cells only.
+ * Points with non-finite coordinates (NaN, inf) are dropped on upload, their number is displayed next to the number of points.
+ * \author tkornuta
+ * \tparam eT Precision (float/double) (DEFAULT=float).
+ */
+template <typename eT = float>
+class WindowScatter: public Window {
+public:
+	/*!
+	 * Constructor.
+	 */
+	WindowScatter(std::string name_ = "WindowScatter",
+			unsigned int position_x_ = 0, unsigned int position_y_ = 0,
+			unsigned int width_ = 512, unsigned int height_ = 512) :
+		Window(name_, position_x_, position_y_, width_, height_),
+		mode(Scatter_Auto),
+		point_size(2.0f),
+		number_of_points(0),
+		dropped_points(0),
+		buffer_id(0),
+		grid_size(1),
+		hovered(-1),
+		mouse_x(-1), mouse_y(-1),
+		label_colormap(Colormap_Categorical),
+		density_colormap(Colormap_Magma),
+		density_revision(0),
+		data_published(false)
+	{
+		min_x = max_x = min_y = max_y = 0.0f;
+		// Register additional key handler.
+		REGISTER_KEY_HANDLER('d', "d - toggles display mode (auto/points/density)", &WindowScatter<eT>::keyhandlerToggleMode);
+	}
+
+	/*!
+	 * Destructor. Releases the buffer object.
+	 */
+	virtual ~WindowScatter() {
+		if (buffer_id != 0)
+			glDeleteBuffers(1, &buffer_id);
+	}
+
+	/*!
+	 * Changes display mode.
+	 */
+	void keyhandlerToggleMode(void) {
+		// Enter critical section.
+		APP_DATA_SYNCHRONIZATION_SCOPED_LOCK();
+		mode = (ScatterMode)((mode + 1) % Scatter_Count);
+		LOG(LINFO) << mode2str(mode);
+		// End of critical section.
+	}
+
+	/*!
+	 * Sets size of drawn points.
+	 * @param size_ Size (in pixels).
+	 */
+	void setPointSize(float size_) {
+		// Enter critical section.
+		APP_DATA_SYNCHRONIZATION_SCOPED_LOCK();
+		point_size = size_;
+		// End of critical section.
+	}
+
+	/*!
+	 * Finds point under the mouse pointer.
+	 * @param x X coordinate of the mouse pointer.
+	 * @param y Y coordinate of the mouse pointer.
+	 */
+	void passiveMotionHandler(int x, int y) {
+		// Enter critical section.
+		APP_DATA_SYNCHRONIZATION_SCOPED_LOCK();
+		mouse_x = x;
+		mouse_y = y;
+		// End of critical section.
+	}
+
+	/*!
+	 * Refreshes the content of the window.
+	 */
+	void displayHandler(void){
+		LOG(LTRACE) << "WindowScatter::Display handler of window " << glutGetWindow();
+		// Enter critical section.
+		APP_DATA_SYNCHRONIZATION_SCOPED_LOCK();
+
+		// Clear buffer.
+		glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+		if (data_published) {
+			uploadPoints();
+			buildGrid();
+			data_published = false;
+			// Force recomputation of the density.
+			density_revision = 0;
+		}//: if
+
+		// Chart area.
+		plot_x0 = (float)margin_left;
+		plot_y0 = (float)margin;
+		plot_x1 = std::max(plot_x0 + 1.0f, (float)viewport_width - margin);
+		plot_y1 = std::max(plot_y0 + 1.0f, (float)viewport_height - margin_bottom);
+		scale_x = (plot_x1 - plot_x0) / (max_x - min_x);
+		scale_y = (plot_y1 - plot_y0) / (max_y - min_y);
+
+		if (number_of_points > 0) {
+			// Use density when points overflow pixels.
+			bool density = (mode == Scatter_Density) ||
+					((mode == Scatter_Auto) && (number_of_points > (size_t)((plot_x1 - plot_x0) * (plot_y1 - plot_y0))));
+			if (density)
+				drawDensity();
+			else
+				drawPoints();
+
+			pick();
+			drawHovered();
+		}//: if
+
+		drawAxes();
+
+		// Swap buffers.
+		glutSwapBuffers();
+
+		// End of critical section.
+	}
+
+	/*!
+	 * Sets displayed points.
+	 * @param points_ptr_ Pointer to the matrix of points (one point per row, x and y in columns).
+	 * @param labels_ptr_ Pointer to labels of points (optional, used for colouring).
+	 */
+	void setDataPointerSynchronized(mic::types::MatrixPtr<eT> points_ptr_, std::shared_ptr<std::vector<size_t> > labels_ptr_ = nullptr) {
+		// Enter critical section.
+		APP_DATA_SYNCHRONIZATION_SCOPED_LOCK();
+		setDataPointerUnsynchronized(points_ptr_, labels_ptr_);
+		// End of critical section.
+	}
+
+	/*!
+	 * Sets displayed points. Unsynchronized i.e. must be used inside of manually synchronized section.
+	 * @param points_ptr_ Pointer to the matrix of points (one point per row, x and y in columns).
+	 * @param labels_ptr_ Pointer to labels of points (optional, used for colouring).
+	 */
+	void setDataPointerUnsynchronized(mic::types::MatrixPtr<eT> points_ptr_, std::shared_ptr<std::vector<size_t> > labels_ptr_ = nullptr) {
+		points_ptr = points_ptr_;
+		labels_ptr = labels_ptr_;
+		data_published = true;
+	}
+
+	/*!
+	 * Returns description of a given display mode.
+	 * @param mode_ Mode.
+	 */
+	static std::string mode2str(ScatterMode mode_) {
+		switch(mode_) {
+		case Scatter_Points:
+			return "Display all points";
+		case Scatter_Density:
+			return "Display density of points";
+		case Scatter_Auto:
+		default:
+			return "Display points, switch to density when there are more points than pixels";
+		}//: switch
+	}
+
+private:
+
+	/*!
+	 * Copies points to the buffer object, computes their bounds and colours. Points with non-finite coordinates are dropped.
+	 */
+	void uploadPoints() {
+		number_of_points = 0;
+		dropped_points = 0;
+		if ((points_ptr == nullptr) || (points_ptr->cols() < 2) || (points_ptr->rows() == 0))
+			return;
+		size_t rows = points_ptr->rows();
+
+		// Interleave coordinates.
+		positions.resize(2 * rows);
+		Eigen::Map<Eigen::Matrix<float, 2, Eigen::Dynamic> > all(positions.data(), 2, rows);
+		all = points_ptr->leftCols(2).transpose().template cast<float>();
+
+		// Drop non-finite points (in place), remember rows of the remaining ones.
+		point_rows.resize(rows);
+		for (size_t i = 0; i < rows; i++) {
+			float x = positions[2*i];
+			float y = positions[2*i + 1];
+			if (!std::isfinite(x) || !std::isfinite(y))
+				continue;
+			positions[2*number_of_points] = x;
+			positions[2*number_of_points + 1] = y;
+			point_rows[number_of_points++] = (unsigned int)i;
+		}//: for
+		dropped_points = rows - number_of_points;
+		positions.resize(2 * number_of_points);
+		point_rows.resize(number_of_points);
+		if (number_of_points == 0)
+			return;
+
+		// Compute bounds, add margins so the points are not drawn on the frame.
+		Eigen::Map<Eigen::Matrix<float, 2, Eigen::Dynamic> > interleaved(positions.data(), 2, number_of_points);
+		min_x = interleaved.row(0).minCoeff();
+		max_x = interleaved.row(0).maxCoeff();
+		min_y = interleaved.row(1).minCoeff();
+		max_y = interleaved.row(1).maxCoeff();
+		float pad_x = (max_x > min_x) ? 0.02f * (max_x - min_x) : 0.5f;
+		float pad_y = (max_y > min_y) ? 0.02f * (max_y - min_y) : 0.5f;
+		min_x -= pad_x; max_x += pad_x;
+		min_y -= pad_y; max_y += pad_y;
+
+		// Colour by labels.
+		colors.resize(number_of_points);
+		if ((labels_ptr != nullptr) && (labels_ptr->size() >= rows)) {
+			const size_t* labels = labels_ptr->data();
+			for (size_t i = 0; i < number_of_points; i++)
+				colors[i] = label_colormap.color(labels[point_rows[i]]);
+		} else
+			std::fill(colors.begin(), colors.end(), Colormap::pack(0.5f, 0.7f, 1.0f));
+
+		// Upload positions followed by colours.
+		if (buffer_id == 0)
+			glGenBuffers(1, &buffer_id);
+		glBindBuffer(GL_ARRAY_BUFFER, buffer_id);
+		size_t positions_bytes = positions.size() * sizeof(float);
+		glBufferData(GL_ARRAY_BUFFER, positions_bytes + colors.size() * sizeof(uint32_t), NULL, GL_STATIC_DRAW);
+		glBufferSubData(GL_ARRAY_BUFFER, 0, positions_bytes, positions.data());
+		glBufferSubData(GL_ARRAY_BUFFER, positions_bytes, colors.size() * sizeof(uint32_t), colors.data());
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+		// Update labels of axes.
+		std::ostringstream stream;
+		stream << min_x; min_x_label = stream.str(); stream.str("");
+		stream << max_x; max_x_label = stream.str(); stream.str("");
+		stream << min_y; min_y_label = stream.str(); stream.str("");
+		stream << max_y; max_y_label = stream.str(); stream.str("");
+		stream << number_of_points << " points";
+		if (dropped_points > 0)
+			stream << " (" << dropped_points << " non-finite dropped)";
+		count_label = stream.str();
+	}
+
+	/*!
+	 * Builds uniform grid indexing points (cells store indices of points in a single array, sorted by cells).
+	 */
+	void buildGrid() {
+		if (number_of_points == 0)
+			return;
+		// A few points per cell on average.
+		grid_size = std::min<size_t>(1024, std::max<size_t>(1, (size_t)std::sqrt((double)number_of_points / 4.0)));
+
+		// Compute cells of points - vectorized by Eigen.
+		Eigen::Map<const Eigen::Array<float, 2, Eigen::Dynamic> > points(positions.data(), 2, number_of_points);
+		Eigen::ArrayXi cx = toCells((points.row(0).transpose() - min_x) * ((float)grid_size / (max_x - min_x)), grid_size);
+		Eigen::ArrayXi cy = toCells((points.row(1).transpose() - min_y) * ((float)grid_size / (max_y - min_y)), grid_size);
+		point_cells = cy * (int)grid_size + cx;
+
+		// Counting sort of points by cells.
+		cell_start.assign(grid_size * grid_size + 1, 0);
+		for (size_t i = 0; i < number_of_points; i++)
+			cell_start[point_cells[i] + 1]++;
+		for (size_t c = 0; c < grid_size * grid_size; c++)
+			cell_start[c + 1] += cell_start[c];
+		cell_points.resize(number_of_points);
+		cell_fill.assign(cell_start.begin(), cell_start.end() - 1);
+		for (size_t i = 0; i < number_of_points; i++)
+			cell_points[cell_fill[point_cells[i]]++] = (unsigned int)i;
+	}
+
+	/*!
+	 * Finds point nearest to the mouse pointer (within the picking radius), visiting only the cells around the pointer.
+	 */
+	void pick() {
+		hovered = -1;
+		if ((mouse_x < plot_x0) || (mouse_x > plot_x1) || (mouse_y < plot_y0) || (mouse_y > plot_y1))
+			return;
+		// Pointer and radius in data coordinates.
+		float px = min_x + ((float)mouse_x - plot_x0) / scale_x;
+		float py = min_y + (plot_y1 - (float)mouse_y) / scale_y;
+		float cells_per_x = (float)grid_size / (max_x - min_x);
+		float cells_per_y = (float)grid_size / (max_y - min_y);
+		int cx0 = toCell((px - pick_radius / scale_x - min_x) * cells_per_x, grid_size);
+		int cx1 = toCell((px + pick_radius / scale_x - min_x) * cells_per_x, grid_size);
+		int cy0 = toCell((py - pick_radius / scale_y - min_y) * cells_per_y, grid_size);
+		int cy1 = toCell((py + pick_radius / scale_y - min_y) * cells_per_y, grid_size);
+
+		// Compare distances in pixels.
+		float best = pick_radius * pick_radius;
+		for (int cy = cy0; cy <= cy1; cy++)
+			for (int cx = cx0; cx <= cx1; cx++) {
+				size_t cell = (size_t)cy * grid_size + (size_t)cx;
+				for (size_t j = cell_start[cell]; j < cell_start[cell + 1]; j++) {
+					unsigned int i = cell_points[j];
+					float dx = (positions[2*i] - px) * scale_x;
+					float dy = (positions[2*i + 1] - py) * scale_y;
+					float distance = dx * dx + dy * dy;
+					if (distance <= best) {
+						best = distance;
+						hovered = (long)i;
+					}//: if
+				}//: for
+			}//: for
+	}
+
+	/*!
+	 * Draws all points with a single call.
+	 */
+	void drawPoints() {
+		glPushMatrix();
+		// Map data coordinates to the chart (y pointing up).
+		glTranslatef(plot_x0 - min_x * scale_x, plot_y1 + min_y * scale_y, 0.0f);
+		glScalef(scale_x, -scale_y, 1.0f);
+
+		glPointSize(point_size);
+		glBindBuffer(GL_ARRAY_BUFFER, buffer_id);
+		glEnableClientState(GL_VERTEX_ARRAY);
+		glEnableClientState(GL_COLOR_ARRAY);
+		glVertexPointer(2, GL_FLOAT, 0, 0);
+		glColorPointer(4, GL_UNSIGNED_BYTE, 0, (const GLvoid*)(positions.size() * sizeof(float)));
+		glDrawArrays(GL_POINTS, 0, (GLsizei)number_of_points);
+		glDisableClientState(GL_COLOR_ARRAY);
+		glDisableClientState(GL_VERTEX_ARRAY);
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+		glPointSize(1.0f);
+
+		glPopMatrix();
+	}
+
+	/*!
+	 * Draws density of points - counts of points falling into pixels of the chart, recomputed only when points or the viewport change.
+	 */
+	void drawDensity() {
+		size_t width = (size_t)(plot_x1 - plot_x0);
+		size_t height = (size_t)(plot_y1 - plot_y0);
+		if ((width == 0) || (height == 0))
+			return;
+
+		if (density_revision != viewport_revision) {
+			// Compute pixels of points - vectorized by Eigen.
+			Eigen::Map<const Eigen::Array<float, 2, Eigen::Dynamic> > points(positions.data(), 2, number_of_points);
+			Eigen::ArrayXi px = toCells((points.row(0).transpose() - min_x) * ((float)width / (max_x - min_x)), width);
+			Eigen::ArrayXi py = toCells((max_y - points.row(1).transpose()) * ((float)height / (max_y - min_y)), height);
+			Eigen::ArrayXi pixels = py * (int)width + px;
+
+			// Count.
+			density.assign(width * height, 0.0f);
+			for (size_t i = 0; i < number_of_points; i++)
+				density[pixels[i]] += 1.0f;
+
+			// Log scale.
+			Eigen::Map<Eigen::ArrayXf> counts(density.data(), density.size());
+			counts = counts.log1p();
+			density_rgba.resize(density.size());
+			density_colormap.apply(density.data(), density.size(), 0.0f, counts.maxCoeff(), density_rgba.data());
+			density_texture.uploadRGBA(width, height, density_rgba.data());
+			density_revision = viewport_revision;
+		}//: if
+
+		glEnable(GL_TEXTURE_2D);
+		glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_REPLACE);
+		density_texture.bind();
+		density_texture.draw(plot_x0, plot_y0, (float)height, (float)width);
+		density_texture.unbind();
+		glDisable(GL_TEXTURE_2D);
+	}
+
+	/*!
+	 * Highlights the point under the mouse pointer and displays its coordinates.
+	 */
+	void drawHovered() {
+		if (hovered < 0)
+			return;
+		float x = positions[2*hovered];
+		float y = positions[2*hovered + 1];
+		float sx = plot_x0 + (x - min_x) * scale_x;
+		float sy = plot_y1 - (y - min_y) * scale_y;
+		draw_circle(sx, sy, 2.0f * pick_radius, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f);
+
+		size_t row = point_rows[hovered];
+		std::ostringstream stream;
+		stream << "#" << row << " (" << x << ", " << y << ")";
+		if ((labels_ptr != nullptr) && (labels_ptr->size() > row))
+			stream << " label " << (*labels_ptr)[row];
+		hovered_label = stream.str();
+		draw_text(plot_x0 + 4.0f, plot_y0 + 12.0f, const_cast<char*>(hovered_label.c_str()), 1.0f, 1.0f, 1.0f, 1.0f, GLUT_BITMAP_HELVETICA_10);
+	}
+
+	/*!
+	 * Quantizes positions into cells (pixels). NaN-safe: positions are clamped to [0, cells_-1] before the cast, NaNs go to the first cell.
+	 * @param positions_ Positions (in cells).
+	 * @param cells_ Number of cells.
+	 */
+	static Eigen::ArrayXi toCells(const Eigen::ArrayXf & positions_, size_t cells_) {
+		return positions_.isNaN().select(0.0f, positions_).max(0.0f).min((float)(cells_ - 1)).cast<int>();
+	}
+
+	/*!
+	 * Quantizes a single position into a cell, see toCells().
+	 * @param position_ Position (in cells).
+	 * @param cells_ Number of cells.
+	 */
+	static int toCell(float position_, size_t cells_) {
+		if (std::isnan(position_))
+			return 0;
+		return (int)std::max(0.0f, std::min(position_, (float)(cells_ - 1)));
+	}
+
+	/*!
+	 * Draws frame of the chart, zero axes and ranges of coordinates.
+	 */
+	void drawAxes() {
+		glLineWidth(1.0f);
+		draw_rectangle(plot_x0, plot_y0, plot_y1 - plot_y0, plot_x1 - plot_x0, 0.7f, 0.7f, 0.7f, 1.0f);
+		if (number_of_points == 0)
+			return;
+
+		// Zero axes (if visible).
+		glColor4f(0.5f, 0.5f, 0.5f, 0.6f);
+		glBegin(GL_LINES);
+		if ((min_x < 0.0f) && (max_x > 0.0f)) {
+			float x = plot_x0 - min_x * scale_x;
+			glVertex2f(x, plot_y0);
+			glVertex2f(x, plot_y1);
+		}//: if
+		if ((min_y < 0.0f) && (max_y > 0.0f)) {
+			float y = plot_y1 + min_y * scale_y;
+			glVertex2f(plot_x0, y);
+			glVertex2f(plot_x1, y);
+		}//: if
+		glEnd();
+
+		// Ranges.
+		draw_text(plot_x0, plot_y1 + 12.0f, const_cast<char*>(min_x_label.c_str()), 1.0f, 1.0f, 1.0f, 1.0f, GLUT_BITMAP_HELVETICA_10);
+		draw_text(plot_x1 - 6.0f * (float)max_x_label.size(), plot_y1 + 12.0f, const_cast<char*>(max_x_label.c_str()), 1.0f, 1.0f, 1.0f, 1.0f, GLUT_BITMAP_HELVETICA_10);
+		draw_text(2.0f, plot_y1, const_cast<char*>(min_y_label.c_str()), 1.0f, 1.0f, 1.0f, 1.0f, GLUT_BITMAP_HELVETICA_10);
+		draw_text(2.0f, plot_y0 + 10.0f, const_cast<char*>(max_y_label.c_str()), 1.0f, 1.0f, 1.0f, 1.0f, GLUT_BITMAP_HELVETICA_10);
+		draw_text((plot_x0 + plot_x1) / 2.0f - 3.0f * (float)count_label.size(), plot_y1 + 12.0f, const_cast<char*>(count_label.c_str()), 0.7f, 0.7f, 0.7f, 1.0f, GLUT_BITMAP_HELVETICA_10);
+	}
+
+	/// Pointer to displayed points.
+	mic::types::MatrixPtr<eT> points_ptr;
+
+	/// Pointer to labels of points.
+	std::shared_ptr<std::vector<size_t> > labels_ptr;
+
+	/// Display mode.
+	ScatterMode mode;
+
+	/// Size of drawn points (in pixels).
+	float point_size;
+
+	/// Number of uploaded points.
+	size_t number_of_points;
+
+	/// Number of points dropped because of non-finite coordinates.
+	size_t dropped_points;
+
+	/// Rows of uploaded points in the displayed matrix.
+	std::vector<unsigned int> point_rows;
+
+	/// Interleaved coordinates of uploaded points (used for picking and density).
+	std::vector<float> positions;
+
+	/// Colours of uploaded points.
+	std::vector<uint32_t> colors;
+
+	/// Id of the vertex buffer object storing positions and colours of points.
+	GLuint buffer_id;
+
+	/// Bounds of points (with margins).
+	float min_x, max_x, min_y, max_y;
+
+	/// Chart area (in pixels).
+	float plot_x0, plot_y0, plot_x1, plot_y1;
+
+	/// Scale of data coordinates (pixels per unit).
+	float scale_x, scale_y;
+
+	/// Number of cells of the grid (in each dimension).
+	size_t grid_size;
+
+	/// Cells of points.
+	Eigen::ArrayXi point_cells;
+
+	/// Index of the first point of every cell in cell_points (plus the total number of points).
+	std::vector<size_t> cell_start;
+
+	/// Indices of points sorted by cells.
+	std::vector<unsigned int> cell_points;
+
+	/// Next free slot of every cell (used during building of the grid).
+	std::vector<size_t> cell_fill;
+
+	/// Index of the point under the mouse pointer (-1 if none).
+	long hovered;
+
+	/// Position of the mouse pointer.
+	int mouse_x, mouse_y;
+
+	/// Colours of labels.
+	Colormap label_colormap;
+
+	/// Colormap of the density.
+	Colormap density_colormap;
+
+	/// Counts of points per pixel.
+	std::vector<float> density;
+
+	/// Colours of the density.
+	std::vector<uint32_t> density_rgba;
+
+	/// Texture storing the density.
+	Texture2D density_texture;
+
+	/// Viewport revision the density was computed for (0 - outdated).
+	unsigned long density_revision;
+
+	/// Cached labels.
+	std::string min_x_label, max_x_label, min_y_label, max_y_label, count_label, hovered_label;
+
+	/// Flag indicating that new points were published and must be uploaded.
+	bool data_published;
+
+	/// Left margin of the chart (room for labels of the y axis).
+	static const int margin_left = 40;
+
+	/// Bottom margin of the chart (room for labels of the x axis).
+	static const int margin_bottom = 20;
+
+	/// Top and right margins of the chart.
+	static const int margin = 10;
+
+	/// Max distance between the mouse pointer and the picked point (in pixels).
+	static constexpr float pick_radius = 5.0f;
+};
+
+} /* namespace visualization */
+} /* namespace opengl */
+} /* namespace mic */
+
+#endif /* SRC_OPENGL_VISUALIZATION_WINDOWSCATTER_HPP_ */
@@ -0,0 +1,454 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file WindowSparklines.hpp
+ * \brief Contains declaration (and definition) of a window displaying hundreds of time series as a grid of sparklines.
+ * \author tkornuta
+ * \date Oct 18, 2026
+ */
+
+#ifndef SRC_OPENGL_VISUALIZATION_WINDOWSPARKLINES_HPP_
+#define SRC_OPENGL_VISUALIZATION_WINDOWSPARKLINES_HPP_
+
+#include <opengl/visualization/Window.hpp>
+#include <opengl/visualization/WindowManager.hpp>
+
+// Dependencies on core types.
+#include <types/MatrixTypes.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace mic {
+namespace opengl {
+namespace visualization {
+
+/*!
+ * \brief OpenGL-based window displaying hundreds of time series (e.g. activations of neurons or statistics of layers) as a grid of tiny charts.
+ *
+ * Every trace stores a fixed number of the most recent samples in a ring buffer and is scaled to its own range.
+ * Vertices of all traces are stored in a single vertex buffer object (in grid units, so the layout is scaled with the modelview transformation) and drawn with a single glMultiDrawArrays call.
+ * Only the traces that changed since the last frame are uploaded. The trace under the mouse pointer is highlighted and its values are displayed.
+ * \author tkornuta
+ * \tparam eT Precision (float/double) (DEFAULT=float).
+ */
+template <typename eT = float>
+class WindowSparklines: public Window {
+public:
+	/*!
+	 * Constructor.
+	 * @param capacity_ Number of samples displayed in every trace (DEFAULT=128).
+	 */
+	WindowSparklines(std::string name_ = "WindowSparklines",
+			unsigned int position_x_ = 0, unsigned int position_y_ = 0,
+			unsigned int width_ = 512, unsigned int height_ = 512,
+			size_t capacity_ = 128) :
+		Window(name_, position_x_, position_y_, width_, height_),
+		capacity(std::max<size_t>(2, capacity_)),
+		number_of_traces(0),
+		columns(1),
+		rows(1),
+		buffer_id(0),
+		buffer_traces(0),
+		buffer_outdated(true),
+		hovered(-1),
+		mouse_x(-1), mouse_y(-1)
+	{
+	}
+
+	/*!
+	 * Destructor. Releases the buffer object.
+	 */
+	virtual ~WindowSparklines() {
+		if (buffer_id != 0)
+			glDeleteBuffers(1, &buffer_id);
+	}
+
+	/*!
+	 * Stores position of the mouse pointer (used for picking of the trace).
+	 * @param x X coordinate of the mouse pointer.
+	 * @param y Y coordinate of the mouse pointer.
+	 */
+	void passiveMotionHandler(int x, int y) {
+		// Enter critical section.
+		APP_DATA_SYNCHRONIZATION_SCOPED_LOCK();
+		mouse_x = x;
+		mouse_y = y;
+		// End of critical section.
+	}
+
+	/*!
+	 * Refreshes the content of the window.
+	 */
+	void displayHandler(void){
+		LOG(LTRACE) << "WindowSparklines::Display handler of window " << glutGetWindow();
+		// Enter critical section.
+		APP_DATA_SYNCHRONIZATION_SCOPED_LOCK();
+
+		// Clear buffer.
+		glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+		if (number_of_traces > 0) {
+			updateLayout();
+			uploadTraces();
+
+			float cell_width = (float)viewport_width / columns;
+			float cell_height = (float)viewport_height / rows;
+
+			// Frames of cells.
+			draw_grid(0.3f, 0.3f, 0.3f, 0.5f, columns, rows);
+
+			// Highlight trace under the mouse pointer.
+			pick(cell_width, cell_height);
+			if (hovered >= 0)
+				draw_filled_rectangle((hovered % columns) * cell_width, (hovered / columns) * cell_height, cell_height, cell_width, 0.2f, 0.2f, 0.3f, 1.0f);
+
+			drawTraces(cell_width, cell_height);
+			drawHovered();
+		}//: if
+
+		// Swap buffers.
+		glutSwapBuffers();
+
+		// End of critical section.
+	}
+
+	/*!
+	 * Appends a sample to every trace - elements of the matrix are assigned to consecutive traces (e.g. activations of neurons of a layer).
+	 * @param samples_ptr_ Pointer to the matrix of samples.
+	 */
+	void appendSamplesSynchronized(mic::types::MatrixPtr<eT> samples_ptr_) {
+		// Enter critical section.
+		APP_DATA_SYNCHRONIZATION_SCOPED_LOCK();
+		appendSamplesUnsynchronized(samples_ptr_);
+		// End of critical section.
+	}
+
+	/*!
+	 * Appends a sample to every trace. Unsynchronized i.e. must be used inside of manually synchronized section.
+	 * @param samples_ptr_ Pointer to the matrix of samples.
+	 */
+	void appendSamplesUnsynchronized(mic::types::MatrixPtr<eT> samples_ptr_) {
+		if (samples_ptr_ == nullptr)
+			return;
+		size_t size = samples_ptr_->size();
+		const eT* data = samples_ptr_->data();
+		for (size_t i = 0; i < size; i++)
+			appendSampleUnsynchronized(i, data[i]);
+	}
+
+	/*!
+	 * Appends a sample to a given trace (e.g. a statistic of a layer). Traces are added when required.
+	 * @param trace_ Index of the trace.
+	 * @param value_ Value of the sample.
+	 */
+	void appendSampleSynchronized(size_t trace_, eT value_) {
+		// Enter critical section.
+		APP_DATA_SYNCHRONIZATION_SCOPED_LOCK();
+		appendSampleUnsynchronized(trace_, value_);
+		// End of critical section.
+	}
+
+	/*!
+	 * Appends a sample to a given trace. Unsynchronized i.e. must be used inside of manually synchronized section.
+	 * @param trace_ Index of the trace.
+	 * @param value_ Value of the sample.
+	 */
+	void appendSampleUnsynchronized(size_t trace_, eT value_) {
+		if (trace_ >= number_of_traces)
+			resizeTraces(trace_ + 1);
+		samples[trace_ * capacity + heads[trace_]] = (float)value_;
+		heads[trace_] = (heads[trace_] + 1) % capacity;
+		lengths[trace_] = std::min(lengths[trace_] + 1, capacity);
+		changed[trace_] = true;
+	}
+
+	/*!
+	 * Sets label of a given trace (displayed when the trace is under the mouse pointer).
+	 * @param trace_ Index of the trace.
+	 * @param label_ Label.
+	 */
+	void setTraceLabel(size_t trace_, std::string label_) {
+		// Enter critical section.
+		APP_DATA_SYNCHRONIZATION_SCOPED_LOCK();
+		if (trace_ >= number_of_traces)
+			resizeTraces(trace_ + 1);
+		labels[trace_] = label_;
+		// End of critical section.
+	}
+
+	/*!
+	 * Removes all traces.
+	 */
+	void clear() {
+		// Enter critical section.
+		APP_DATA_SYNCHRONIZATION_SCOPED_LOCK();
+		resizeTraces(0);
+		// End of critical section.
+	}
+
+private:
+
+	/*!
+	 * Changes number of traces (new traces are empty).
+	 * @param number_of_traces_ Number of traces.
+	 */
+	void resizeTraces(size_t number_of_traces_) {
+		number_of_traces = number_of_traces_;
+		samples.resize(number_of_traces * capacity);
+		heads.resize(number_of_traces, 0);
+		lengths.resize(number_of_traces, 0);
+		changed.resize(number_of_traces, true);
+		min_values.resize(number_of_traces, 0.0f);
+		max_values.resize(number_of_traces, 0.0f);
+		labels.resize(number_of_traces);
+		vertices.resize(2 * number_of_traces * capacity);
+	}
+
+	/*!
+	 * Computes number of columns and rows, so cells are roughly three times wider than higher. Vertices are stored in grid units, so all traces must be uploaded again when the layout changes.
+	 */
+	void updateLayout() {
+		size_t new_columns = (size_t)std::floor(std::sqrt((float)number_of_traces * viewport_width / (3.0f * viewport_height)) + 0.5f);
+		new_columns = std::min(std::max<size_t>(1, new_columns), number_of_traces);
+		size_t new_rows = (number_of_traces + new_columns - 1) / new_columns;
+		if ((new_columns != columns) || (new_rows != rows)) {
+			columns = new_columns;
+			rows = new_rows;
+			std::fill(changed.begin(), changed.end(), true);
+			buffer_outdated = true;
+		}//: if
+	}
+
+	/*!
+	 * Computes vertices of the changed traces and uploads them to the buffer object.
+	 */
+	void uploadTraces() {
+		size_t changed_traces = 0;
+		for (size_t i = 0; i < number_of_traces; i++)
+			if (changed[i]) {
+				buildTrace(i);
+				changed_traces++;
+			}//: if
+
+		if (buffer_id == 0)
+			glGenBuffers(1, &buffer_id);
+		glBindBuffer(GL_ARRAY_BUFFER, buffer_id);
+		if (buffer_outdated || (buffer_traces < number_of_traces) || (2 * changed_traces > number_of_traces)) {
+			// Upload everything at once.
+			if (buffer_traces < number_of_traces) {
+				buffer_traces = number_of_traces;
+				glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(GLfloat), vertices.data(), GL_DYNAMIC_DRAW);
+			} else
+				glBufferSubData(GL_ARRAY_BUFFER, 0, vertices.size() * sizeof(GLfloat), vertices.data());
+		} else {
+			// Upload only the changed traces.
+			for (size_t i = 0; i < number_of_traces; i++)
+				if (changed[i]) {
+					size_t first = i * capacity + capacity - lengths[i];
+					glBufferSubData(GL_ARRAY_BUFFER, 2 * first * sizeof(GLfloat), 2 * lengths[i] * sizeof(GLfloat), &vertices[2 * first]);
+				}//: if
+		}//: else
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+		std::fill(changed.begin(), changed.end(), false);
+		buffer_outdated = false;
+	}
+
+	/*!
+	 * Computes range and vertices of a given trace - samples are placed in its cell (in grid units), the newest one at the right border.
+	 * @param trace_ Index of the trace.
+	 */
+	void buildTrace(size_t trace_) {
+		size_t length = lengths[trace_];
+		if (length == 0)
+			return;
+		const float* ring = &samples[trace_ * capacity];
+		// The oldest sample.
+		size_t tail = (heads[trace_] + capacity - length) % capacity;
+
+		float min_value = ring[tail];
+		float max_value = ring[tail];
+		for (size_t j = 0; j < length; j++) {
+			float value = ring[(tail + j) % capacity];
+			min_value = std::min(min_value, value);
+			max_value = std::max(max_value, value);
+		}//: for
+		min_values[trace_] = min_value;
+		max_values[trace_] = max_value;
+		// Constant traces are placed in the middle of the cell.
+		float scale = (max_value > min_value) ? (1.0f - 2.0f * padding) / (max_value - min_value) : 0.0f;
+		float offset = (max_value > min_value) ? 1.0f - padding : 0.5f;
+
+		float x0 = (float)(trace_ % columns) + padding;
+		float y0 = (float)(trace_ / columns) + offset;
+		float step = (1.0f - 2.0f * padding) / (capacity - 1);
+		GLfloat* vertex = &vertices[2 * (trace_ * capacity + capacity - length)];
+		for (size_t j = 0; j < length; j++) {
+			vertex[2 * j] = x0 + (capacity - length + j) * step;
+			vertex[2 * j + 1] = y0 - (ring[(tail + j) % capacity] - min_value) * scale;
+		}//: for
+	}
+
+	/*!
+	 * Draws all traces with a single call, along with their newest samples.
+	 * @param cell_width_ Width of a cell (in pixels).
+	 * @param cell_height_ Height of a cell (in pixels).
+	 */
+	void drawTraces(float cell_width_, float cell_height_) {
+		firsts.clear();
+		counts.clear();
+		newest.clear();
+		for (size_t i = 0; i < number_of_traces; i++)
+			if (lengths[i] > 0) {
+				firsts.push_back((GLint)(i * capacity + capacity - lengths[i]));
+				counts.push_back((GLsizei)lengths[i]);
+				newest.push_back((GLint)((i + 1) * capacity - 1));
+			}//: if
+		if (firsts.empty())
+			return;
+		ones.resize(newest.size(), 1);
+
+		glPushMatrix();
+		glScalef(cell_width_, cell_height_, 1.0f);
+		glBindBuffer(GL_ARRAY_BUFFER, buffer_id);
+		glEnableClientState(GL_VERTEX_ARRAY);
+		glVertexPointer(2, GL_FLOAT, 0, 0);
+
+		glLineWidth(1.0f);
+		glColor4f(0.3f, 0.8f, 1.0f, 1.0f);
+		glMultiDrawArrays(GL_LINE_STRIP, firsts.data(), counts.data(), (GLsizei)firsts.size());
+
+		glPointSize(3.0f);
+		glColor4f(1.0f, 0.6f, 0.0f, 1.0f);
+		glMultiDrawArrays(GL_POINTS, newest.data(), ones.data(), (GLsizei)newest.size());
+		glPointSize(1.0f);
+
+		glDisableClientState(GL_VERTEX_ARRAY);
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+		glPopMatrix();
+	}
+
+	/*!
+	 * Finds trace under the mouse pointer.
+	 * @param cell_width_ Width of a cell (in pixels).
+	 * @param cell_height_ Height of a cell (in pixels).
+	 */
+	void pick(float cell_width_, float cell_height_) {
+		hovered = -1;
+		if ((mouse_x < 0) || (mouse_y < 0) || (mouse_x >= (int)viewport_width) || (mouse_y >= (int)viewport_height))
+			return;
+		size_t trace = (size_t)(mouse_y / cell_height_) * columns + (size_t)(mouse_x / cell_width_);
+		if (trace < number_of_traces)
+			hovered = (long)trace;
+	}
+
+	/*!
+	 * Displays label, the newest value and the range of the trace under the mouse pointer.
+	 */
+	void drawHovered() {
+		if ((hovered < 0) || (lengths[hovered] == 0))
+			return;
+		std::ostringstream stream;
+		if (labels[hovered].empty())
+			stream << "#" << hovered;
+		else
+			stream << labels[hovered];
+		stream << ": " << samples[hovered * capacity + (heads[hovered] + capacity - 1) % capacity]
+				<< "  (" << min_values[hovered] << " : " << max_values[hovered] << ")";
+		hovered_label = stream.str();
+		draw_text(4.0f, 12.0f, const_cast<char*>(hovered_label.c_str()), 1.0f, 1.0f, 1.0f, 1.0f, GLUT_BITMAP_HELVETICA_10);
+	}
+
+	/// Number of samples stored in every trace.
+	size_t capacity;
+
+	/// Number of traces.
+	size_t number_of_traces;
+
+	/// Samples of traces (ring buffers of consecutive traces).
+	std::vector<float> samples;
+
+	/// Index of slot in which the next sample of every trace will be stored.
+	std::vector<size_t> heads;
+
+	/// Number of samples stored in every trace.
+	std::vector<size_t> lengths;
+
+	/// Flags indicating that traces changed since the last frame.
+	std::vector<bool> changed;
+
+	/// Min values of traces.
+	std::vector<float> min_values;
+
+	/// Max values of traces.
+	std::vector<float> max_values;
+
+	/// Labels of traces.
+	std::vector<std::string> labels;
+
+	/// Number of columns of the grid.
+	size_t columns;
+
+	/// Number of rows of the grid.
+	size_t rows;
+
+	/// Vertices of traces (copy of the content of the buffer object).
+	std::vector<GLfloat> vertices;
+
+	/// Id of the vertex buffer object.
+	GLuint buffer_id;
+
+	/// Number of traces allocated in the buffer object.
+	size_t buffer_traces;
+
+	/// Flag indicating that the whole buffer must be uploaded again.
+	bool buffer_outdated;
+
+	/// Indices of the first vertices of traces (passed to glMultiDrawArrays).
+	std::vector<GLint> firsts;
+
+	/// Lengths of traces (passed to glMultiDrawArrays).
+	std::vector<GLsizei> counts;
+
+	/// Indices of the newest vertices of traces.
+	std::vector<GLint> newest;
+
+	/// Counts of single vertices.
+	std::vector<GLsizei> ones;
+
+	/// Index of the trace under the mouse pointer (-1 if none).
+	long hovered;
+
+	/// Position of the mouse pointer.
+	int mouse_x, mouse_y;
+
+	/// Cached label of the hovered trace.
+	std::string hovered_label;
+
+	/// Margin between the trace and the border of its cell (in grid units).
+	static constexpr float padding = 0.1f;
+};
+
+} /* namespace visualization */
+} /* namespace opengl */
+} /* namespace mic */
+
+#endif /* SRC_OPENGL_VISUALIZATION_WINDOWSPARKLINES_HPP_ */
@@ -0,0 +1,314 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file WindowSparseMatrix.hpp
+ * \brief Window displaying non-zero entries of a sparse matrix.
+ * \author tkornuta
+ * \date Oct 18, 2026
+ */
+
+#ifndef SRC_OPENGL_VISUALIZATION_WINDOWSPARSEMATRIX_HPP_
+#define SRC_OPENGL_VISUALIZATION_WINDOWSPARSEMATRIX_HPP_
+
+#include <opengl/visualization/Window.hpp>
+#include <opengl/visualization/WindowManager.hpp>
+#include <opengl/visualization/Grayscale.hpp>
+#include <opengl/visualization/Colormap.hpp>
+
+#include <Eigen/Sparse>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <stdint.h>
+#include <vector>
+
+namespace mic {
+namespace opengl {
+namespace visualization {
+
+/*!
+ * \brief OpenGL-based window responsible for displaying sparse matrices.
+ *
+ * Only non-zero entries are drawn - as quads batched into a single vertex array. When the matrix is denser than the screen, entries are aggregated into pixel bins
+ * (keeping the value of the largest magnitude, so outliers remain visible). Vertices are rebuilt only on publication or reshape, at a cost proportional to the number of non-zeros.
+ * \author tkornuta
+ * \tparam eT Precision (float/double) (DEFAULT=float).
+ * \tparam StorageOrder Storage order of the matrix - Eigen::ColMajor (CSC) or Eigen::RowMajor (CSR) (DEFAULT=Eigen::ColMajor).
+ */
+template <typename eT = float, int StorageOrder = Eigen::ColMajor>
+class WindowSparseMatrix: public Window, public Grayscale {
+public:
+	/// Type of the displayed matrix.
+	typedef Eigen::SparseMatrix<eT, StorageOrder> SparseMatrix;
+
+	/// Type of the pointer to the displayed matrix.
+	typedef std::shared_ptr<SparseMatrix> SparseMatrixPtr;
+
+	/*!
+	 * Constructor. NULLs the matrix pointer.
+	 */
+	WindowSparseMatrix(std::string name_ = "SparseMatrix",
+			unsigned int position_x_ = 0, unsigned int position_y_ = 0,
+			unsigned int width_ = 512, unsigned int height_ = 512) :
+		Window(name_, position_x_, position_y_, width_, height_),
+		normalization(Norm_None),
+		bins_revision(0),
+		bins_stamp(0),
+		matrix_published(false)
+	{
+		// NULL pointer.
+		displayed_matrix_ptr = nullptr;
+
+		// Register additional key handler.
+		REGISTER_KEY_HANDLER('n', "n - toggles normalization mode", &WindowSparseMatrix::keyhandlerToggleNormalizationMode);
+		REGISTER_KEY_HANDLER('m', "m - toggles colormap", &WindowSparseMatrix::keyhandlerToggleColormap);
+	}
+
+	/*!
+	 * Virtual destructor - empty.
+	 */
+	virtual ~WindowSparseMatrix() { }
+
+	/*!
+	 * Changes normalization mode.
+	 */
+	void keyhandlerToggleNormalizationMode(void) {
+		// Enter critical section.
+		APP_DATA_SYNCHRONIZATION_SCOPED_LOCK();
+		normalization = (Normalization)((normalization + 1) % 4);
+		// Entries must be recoloured.
+		matrix_published = true;
+		LOG(LINFO) << norm2str(normalization);
+		// End of critical section.
+	}
+
+	/*!
+	 * Changes colormap.
+	 */
+	void keyhandlerToggleColormap(void) {
+		// Enter critical section.
+		APP_DATA_SYNCHRONIZATION_SCOPED_LOCK();
+		colormap.setType((ColormapType)((colormap.getType() + 1) % Colormap_Count));
+		// Entries must be recoloured.
+		matrix_published = true;
+		LOG(LINFO) << Colormap::colormap2str(colormap.getType());
+		// End of critical section.
+	}
+
+	/*!
+	 * Refreshes the content of the window.
+	 */
+	void displayHandler(void){
+		LOG(LTRACE) << "WindowSparseMatrix::Display handler of window " << glutGetWindow();
+		// Enter critical section.
+		APP_DATA_SYNCHRONIZATION_SCOPED_LOCK();
+
+		// Clear buffer.
+		glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+		if (displayed_matrix_ptr != nullptr) {
+			// Rebuild bins when the matrix or the viewport has changed.
+			if (matrix_published || (bins_revision != viewport_revision))
+				buildBins();
+
+			// Draw all entries with a single call.
+			if (!vertices.empty()) {
+				glEnableClientState(GL_VERTEX_ARRAY);
+				glEnableClientState(GL_COLOR_ARRAY);
+				glVertexPointer(2, GL_FLOAT, 0, vertices.data());
+				glColorPointer(4, GL_UNSIGNED_BYTE, 0, colors.data());
+				glDrawArrays(GL_QUADS, 0, (GLsizei)(vertices.size() / 2));
+				glDisableClientState(GL_COLOR_ARRAY);
+				glDisableClientState(GL_VERTEX_ARRAY);
+			}//: if
+		}//: if !null
+
+		// Swap buffers.
+		glutSwapBuffers();
+
+		// End of critical section.
+	}
+
+	/*!
+	 * Sets displayed matrix.
+	 * @param displayed_matrix_ Matrix to be displayed (copied).
+	 */
+	void setMatrixSynchronized(const SparseMatrix & displayed_matrix_) {
+		// Enter critical section.
+		APP_DATA_SYNCHRONIZATION_SCOPED_LOCK();
+		setMatrixUnsynchronized(displayed_matrix_);
+		// End of critical section.
+	}
+
+	/*!
+	 * Sets displayed matrix. Unsynchronized i.e. must be used inside of manually synchronized section.
+	 * @param displayed_matrix_ Matrix to be displayed (copied).
+	 */
+	void setMatrixUnsynchronized(const SparseMatrix & displayed_matrix_) {
+		if (displayed_matrix_ptr == nullptr)
+			displayed_matrix_ptr = std::make_shared<SparseMatrix>(displayed_matrix_);
+		else
+			*displayed_matrix_ptr = displayed_matrix_;
+		matrix_published = true;
+	}
+
+	/*!
+	 * Sets pointer to displayed matrix.
+	 * @param displayed_matrix_ptr_ Pointer to matrix to be displayed.
+	 */
+	void setMatrixPointerSynchronized(SparseMatrixPtr displayed_matrix_ptr_) {
+		// Enter critical section.
+		APP_DATA_SYNCHRONIZATION_SCOPED_LOCK();
+		setMatrixPointerUnsynchronized(displayed_matrix_ptr_);
+		// End of critical section.
+	}
+
+	/*!
+	 * Sets pointer to displayed matrix. Unsynchronized i.e. must be used inside of manually synchronized section.
+	 * @param displayed_matrix_ptr_ Pointer to matrix to be displayed.
+	 */
+	void setMatrixPointerUnsynchronized(SparseMatrixPtr displayed_matrix_ptr_) {
+		displayed_matrix_ptr = displayed_matrix_ptr_;
+		matrix_published = true;
+	}
+
+private:
+
+	/*!
+	 * Aggregates non-zero entries into bins (at most one per pixel) and computes vertices and colours of non-empty bins.
+	 */
+	void buildBins() {
+		size_t rows = displayed_matrix_ptr->rows();
+		size_t cols = displayed_matrix_ptr->cols();
+		vertices.clear();
+		colors.clear();
+		values.clear();
+		occupied_bins.clear();
+		bins_revision = viewport_revision;
+		matrix_published = false;
+		if ((rows == 0) || (cols == 0) || (viewport_width <= 0) || (viewport_height <= 0))
+			return;
+
+		// Bins are entries themselves, unless the matrix is denser than the screen.
+		size_t bin_rows = std::min<size_t>(rows, viewport_height);
+		size_t bin_cols = std::min<size_t>(cols, viewport_width);
+		if (bin_stamps.size() != bin_rows * bin_cols) {
+			bin_stamps.assign(bin_rows * bin_cols, 0);
+			bin_slots.resize(bin_rows * bin_cols);
+			bins_stamp = 0;
+		}//: if
+		// Bins stamped in the previous builds are treated as empty - no need to clear them.
+		bins_stamp++;
+
+		// Iterate only through the stored entries (columns of CSC or rows of CSR).
+		for (Eigen::Index k = 0; k < displayed_matrix_ptr->outerSize(); k++) {
+			for (typename SparseMatrix::InnerIterator it(*displayed_matrix_ptr, k); it; ++it) {
+				eT value = it.value();
+				if (value == (eT)0)
+					continue;
+				size_t bin = ((size_t)it.row() * bin_rows / rows) * bin_cols + ((size_t)it.col() * bin_cols / cols);
+				if (bin_stamps[bin] != bins_stamp) {
+					bin_stamps[bin] = bins_stamp;
+					bin_slots[bin] = values.size();
+					values.push_back(value);
+					occupied_bins.push_back(bin);
+				} else if (std::abs(value) > std::abs(values[bin_slots[bin]]))
+					values[bin_slots[bin]] = value;
+			}//: for
+		}//: for
+		if (values.empty())
+			return;
+
+		// Colour bins.
+		eT min = *std::min_element(values.begin(), values.end());
+		eT max = *std::max_element(values.begin(), values.end());
+		bin_colors.resize(values.size());
+		if (colormap.getType() != Colormap_None)
+			colormap.apply(values.data(), values.size(), min, max, bin_colors.data());
+		else {
+			eT diff = max - min;
+			if (diff == (eT)0) {
+				min = max = (eT)0;
+				diff = (eT)1;
+			}//: if
+			for (size_t i = 0; i < values.size(); i++) {
+				eT red, green, blue, alpha;
+				colorize(normalization, values[i], min, max, diff, red, green, blue, alpha);
+				bin_colors[i] = Colormap::pack((float)red, (float)green, (float)blue);
+			}//: for
+		}//: else
+
+		// Compute quads of bins.
+		float bin_height = (float)viewport_height / (float)bin_rows;
+		float bin_width = (float)viewport_width / (float)bin_cols;
+		vertices.reserve(8 * values.size());
+		colors.reserve(4 * values.size());
+		for (size_t i = 0; i < occupied_bins.size(); i++) {
+			float x = (float)(occupied_bins[i] % bin_cols) * bin_width;
+			float y = (float)(occupied_bins[i] / bin_cols) * bin_height;
+			vertices.insert(vertices.end(), {x, y, x + bin_width, y, x + bin_width, y + bin_height, x, y + bin_height});
+			colors.insert(colors.end(), 4, bin_colors[i]);
+		}//: for
+	}
+
+	/// Pointer to displayed matrix.
+	SparseMatrixPtr displayed_matrix_ptr;
+
+	/// Normalization mode.
+	Normalization normalization;
+
+	/// Colormap applied to entries (if other than Colormap_None).
+	Colormap colormap;
+
+	/// Vertices of quads of non-empty bins.
+	std::vector<float> vertices;
+
+	/// Colours of vertices (packed RGBA8).
+	std::vector<uint32_t> colors;
+
+	/// Values of non-empty bins.
+	std::vector<eT> values;
+
+	/// Colours of non-empty bins.
+	std::vector<uint32_t> bin_colors;
+
+	/// Indices of non-empty bins.
+	std::vector<size_t> occupied_bins;
+
+	/// Stamps of bins - bin is non-empty if its stamp equals to the stamp of the current build.
+	std::vector<size_t> bin_stamps;
+
+	/// Indices of values of non-empty bins.
+	std::vector<size_t> bin_slots;
+
+	/// Viewport revision the bins were built for.
+	unsigned long bins_revision;
+
+	/// Stamp of the current build.
+	size_t bins_stamp;
+
+	/// Flag indicating that a new matrix was published and bins must be rebuilt.
+	bool matrix_published;
+};
+
+} /* namespace visualization */
+} /* namespace opengl */
+} /* namespace mic */
+
+#endif /* SRC_OPENGL_VISUALIZATION_WINDOWSPARSEMATRIX_HPP_ */
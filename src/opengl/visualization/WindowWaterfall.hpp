@@ -0,0 +1,305 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file WindowWaterfall.hpp
+ * \brief Window displaying history of a streamed vector (e.g. activations, audio features or rewards) as a scrolling waterfall.
+ * \author tkornuta
+ * \date Oct 18, 2026
+ */
+
+#ifndef SRC_OPENGL_VISUALIZATION_WINDOWWATERFALL_HPP_
+#define SRC_OPENGL_VISUALIZATION_WINDOWWATERFALL_HPP_
+
+#include <opengl/visualization/Window.hpp>
+#include <opengl/visualization/WindowManager.hpp>
+#include <opengl/visualization/Grayscale.hpp>
+#include <opengl/visualization/Colormap.hpp>
+#include <opengl/visualization/NormalizationShader.hpp>
+#include <opengl/visualization/Texture2D.hpp>
+
+// Dependencies on core types.
+#include <types/MatrixTypes.hpp>
+
+#include <algorithm>
+#include <deque>
+#include <limits>
+#include <stdint.h>
+#include <vector>
+
+namespace mic {
+namespace opengl {
+namespace visualization {
+
+/*!
+ * \brief OpenGL-based window displaying history of a streamed vector as a waterfall (spectrogram) - every publication adds a row at the top, older rows move down.
+ *
+ * Rows are stored in a circular texture: a new row replaces the oldest one (a single-line glTexSubImage2D, regardless of the depth of the history) and scrolling is done by shifting texture coordinates, without moving the data.
+ * Raw values are coloured on the GPU according to the normalization mode, using min/max of the whole history.
+ * Colormaps are applied on the CPU when the row is added, using min/max known at that moment - the history is recoloured only when the colormap changes.
+ * \author tkornuta
+ * \tparam eT Precision (float/double) (DEFAULT=float).
+ */
+template <typename eT = float>
+class WindowWaterfall: public Window, public Grayscale {
+public:
+	/*!
+	 * Constructor.
+	 * @param history_ Number of displayed rows.
+	 */
+	WindowWaterfall(std::string name_ = "WindowWaterfall",
+			Normalization normalization_ = Norm_Positive,
+			unsigned int position_x_ = 0, unsigned int position_y_ = 0,
+			unsigned int width_ = 512, unsigned int height_ = 512,
+			size_t history_ = 256) :
+		Window(name_, position_x_, position_y_, width_, height_),
+		normalization(normalization_),
+		history_size(std::max<size_t>(1, history_)),
+		row_width(0),
+		head(0),
+		filled(0),
+		displayed_colormapped(false),
+		texture_outdated(true)
+	{
+		// Register additional key handler.
+		REGISTER_KEY_HANDLER('n', "n - toggles normalization mode", &WindowWaterfall<eT>::keyhandlerToggleNormalizationMode);
+		REGISTER_KEY_HANDLER('m', "m - toggles colormap", &WindowWaterfall<eT>::keyhandlerToggleColormap);
+	}
+
+	/*!
+	 * Virtual destructor - empty.
+	 */
+	virtual ~WindowWaterfall() { }
+
+	/*!
+	 * Changes normalization mode.
+	 */
+	void keyhandlerToggleNormalizationMode(void) {
+		// Enter critical section.
+		APP_DATA_SYNCHRONIZATION_SCOPED_LOCK();
+		normalization = (Normalization)((normalization + 1) % 4);
+		LOG(LINFO) << norm2str(normalization);
+		// End of critical section.
+	}
+
+	/*!
+	 * Changes colormap.
+	 */
+	void keyhandlerToggleColormap(void) {
+		// Enter critical section.
+		APP_DATA_SYNCHRONIZATION_SCOPED_LOCK();
+		colormap.setType((ColormapType)((colormap.getType() + 1) % Colormap_Count));
+		// History must be recoloured.
+		texture_outdated = true;
+		LOG(LINFO) << Colormap::colormap2str(colormap.getType());
+		// End of critical section.
+	}
+
+	/*!
+	 * Refreshes the content of the window.
+	 */
+	void displayHandler(void){
+		LOG(LTRACE) << "WindowWaterfall::Display handler of window " << glutGetWindow();
+		// Enter critical section.
+		APP_DATA_SYNCHRONIZATION_SCOPED_LOCK();
+
+		// Clear buffer.
+		glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+		// Colormaps are applied on the CPU, otherwise colour on the GPU. Grayscale ramp is used when shaders are not available.
+		bool use_colormap = (colormap.getType() != Colormap_None) || !shader.build();
+		if (use_colormap != displayed_colormapped)
+			texture_outdated = true;
+		displayed_colormapped = use_colormap;
+
+		// Append rows published since the last frame.
+		while (!pending_rows.empty()) {
+			appendRow(pending_rows.front());
+			pending_rows.pop_front();
+		}//: while
+
+		if (texture_outdated)
+			uploadHistory();
+
+		if (filled > 0) {
+			if (use_colormap) {
+				glEnable(GL_TEXTURE_2D);
+				glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_REPLACE);
+			} else
+				shader.useGrayscale(normalization, historyMin(), historyMax());
+			texture.bind();
+
+			// Newest row at the top: rows from head-1 down to 0, followed by rows from the last one down to head (if the history is full).
+			float row_height = (float)viewport_height / (float)history_size;
+			float split = (float)head / (float)history_size;
+			texture.draw(0.0f, 0.0f, (float)head * row_height, (float)viewport_width, 0.0f, split, 1.0f, 0.0f);
+			if (filled == history_size)
+				texture.draw(0.0f, (float)head * row_height, (float)(history_size - head) * row_height, (float)viewport_width, 0.0f, 1.0f, 1.0f, split);
+
+			texture.unbind();
+			if (use_colormap)
+				glDisable(GL_TEXTURE_2D);
+			else
+				shader.release();
+		}//: if
+
+		// Swap buffers.
+		glutSwapBuffers();
+
+		// End of critical section.
+	}
+
+	/*!
+	 * Adds a row (all elements of the matrix) to the waterfall.
+	 * @param row_ptr_ Pointer to the matrix.
+	 */
+	void setDataPointerSynchronized(mic::types::MatrixPtr<eT> row_ptr_) {
+		// Enter critical section.
+		APP_DATA_SYNCHRONIZATION_SCOPED_LOCK();
+		setDataPointerUnsynchronized(row_ptr_);
+		// End of critical section.
+	}
+
+	/*!
+	 * Adds a row (all elements of the matrix) to the waterfall. Unsynchronized i.e. must be used inside of manually synchronized section.
+	 * Row is copied, so every publication results in a row, even if several of them happen between frames.
+	 * @param row_ptr_ Pointer to the matrix.
+	 */
+	void setDataPointerUnsynchronized(mic::types::MatrixPtr<eT> row_ptr_) {
+		if ((row_ptr_ == nullptr) || (row_ptr_->size() == 0))
+			return;
+		pending_rows.push_back(std::vector<float>(row_ptr_->data(), row_ptr_->data() + row_ptr_->size()));
+		// Rows that would be overwritten anyway are dropped.
+		if (pending_rows.size() > history_size)
+			pending_rows.pop_front();
+	}
+
+private:
+
+	/*!
+	 * Stores the row in the history (replacing the oldest one) and uploads it to the texture.
+	 * @param row_ Values of the row.
+	 */
+	void appendRow(const std::vector<float> & row_) {
+		// Different length - start a new history.
+		if (row_.size() != row_width) {
+			row_width = row_.size();
+			history.assign(history_size * row_width, 0.0f);
+			row_min.assign(history_size, std::numeric_limits<float>::max());
+			row_max.assign(history_size, -std::numeric_limits<float>::max());
+			head = 0;
+			filled = 0;
+			texture_outdated = true;
+		}//: if
+
+		std::copy(row_.begin(), row_.end(), &history[head * row_width]);
+		row_min[head] = *std::min_element(row_.begin(), row_.end());
+		row_max[head] = *std::max_element(row_.begin(), row_.end());
+
+		// Upload a single row (the whole history is uploaded anyway if the texture is outdated).
+		if (!texture_outdated) {
+			if (displayed_colormapped) {
+				rgba.resize(row_width);
+				colormap.apply(&history[head * row_width], row_width, historyMin(), historyMax(), rgba.data());
+				texture.uploadRGBARow(head, rgba.data());
+			} else
+				texture.uploadLuminanceRow(head, &history[head * row_width]);
+		}//: if
+
+		head = (head + 1) % history_size;
+		filled = std::min(filled + 1, history_size);
+	}
+
+	/*!
+	 * Uploads the whole history (e.g. when the colormap changes).
+	 */
+	void uploadHistory() {
+		texture_outdated = false;
+		if (row_width == 0)
+			return;
+		if (displayed_colormapped) {
+			rgba.resize(history.size());
+			colormap.apply(history.data(), history.size(), historyMin(), historyMax(), rgba.data());
+			texture.uploadRGBA(row_width, history_size, rgba.data());
+		} else
+			texture.uploadLuminance(row_width, history_size, history.data());
+	}
+
+	/*!
+	 * Returns min value of the history.
+	 */
+	float historyMin() const {
+		return (filled > 0) ? *std::min_element(row_min.begin(), row_min.end()) : 0.0f;
+	}
+
+	/*!
+	 * Returns max value of the history.
+	 */
+	float historyMax() const {
+		return (filled > 0) ? *std::max_element(row_max.begin(), row_max.end()) : 0.0f;
+	}
+
+	/// Normalization mode.
+	Normalization normalization;
+
+	/// Shader colouring raw values according to the normalization mode.
+	NormalizationShader shader;
+
+	/// Colormap applied to rows (if other than Colormap_None).
+	Colormap colormap;
+
+	/// Circular texture storing rows.
+	Texture2D texture;
+
+	/// Number of rows of the history.
+	size_t history_size;
+
+	/// Number of values in a row.
+	size_t row_width;
+
+	/// Copy of the history (circular buffer of rows), used when the texture must be uploaded again.
+	std::vector<float> history;
+
+	/// Min values of rows.
+	std::vector<float> row_min;
+
+	/// Max values of rows.
+	std::vector<float> row_max;
+
+	/// Buffer storing colours of the uploaded row(s).
+	std::vector<uint32_t> rgba;
+
+	/// Rows published since the last frame.
+	std::deque<std::vector<float> > pending_rows;
+
+	/// Row that will be replaced by the next one.
+	size_t head;
+
+	/// Number of rows stored in the history.
+	size_t filled;
+
+	/// Flag indicating whether the texture stores colours (otherwise raw values).
+	bool displayed_colormapped;
+
+	/// Flag indicating that the whole history must be uploaded again (e.g. when the colormap changes).
+	bool texture_outdated;
+};
+
+} /* namespace visualization */
+} /* namespace opengl */
+} /* namespace mic */
+
+#endif /* SRC_OPENGL_VISUALIZATION_WINDOWWATERFALL_HPP_ */
@@ -0,0 +1,179 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file WorkerPool.cpp
+ * \brief Definitions of methods of WorkerPool class.
+ * \author tkornuta
+ * \date Oct 18, 2026
+ */
+
+#include <opengl/visualization/WorkerPool.hpp>
+
+#include <logger/Log.hpp>
+
+#include <boost/bind.hpp>
+
+#include <algorithm>
+#include <exception>
+
+namespace mic {
+  namespace opengl {
+    namespace visualization {
+
+
+      // Init worker pool instance - as NULL.
+      boost::atomic<WorkerPool*> WorkerPool::instance_(NULL);
+
+
+      // Initilize singleton instantiation mutex.
+      boost::mutex WorkerPool::instantiation_mutex;
+
+      // Static members.
+      const size_t WorkerPool::min_elements_per_task;
+
+      WorkerPool* WorkerPool::getInstance() {
+        // Try to load the instance - first check.
+        WorkerPool* tmp = instance_.load(boost::memory_order_consume);
+        // If instance does not exist.
+        if (!tmp) {
+          // Enter critical section.
+          boost::mutex::scoped_lock guard(instantiation_mutex);
+          // Try to load the instance - second check.
+          tmp = instance_.load(boost::memory_order_consume);
+          // If still does not exist - create new instance.
+          if (!tmp) {
+            tmp = new WorkerPool;
+            instance_.store(tmp, boost::memory_order_release);
+          }//: if
+          // Exit critical section.
+        }//: if
+        // Return instance.
+        return tmp;
+      }
+
+      WorkerPool::WorkerPool() :
+          queued_tasks(0), terminate(false), next_queue(0)
+      {
+        // The thread calling parallelFor() works as well (so there are no workers on a single core).
+        size_t number_of_workers = std::max(boost::thread::hardware_concurrency(), 1u) - 1;
+        LOG(LINFO) << "Starting " << number_of_workers << " visualization worker(s)";
+        for (size_t i = 0; i < number_of_workers; i++)
+          queues.push_back(std::make_shared<WorkerQueue>());
+        for (size_t i = 0; i < number_of_workers; i++)
+          workers.create_thread(boost::bind(&WorkerPool::workerLoop, this, i));
+      }
+
+      WorkerPool::~WorkerPool() {
+        {
+          boost::mutex::scoped_lock lock(wakeup_mutex);
+          terminate = true;
+        }
+        wakeup.notify_all();
+        workers.join_all();
+      }
+
+      void WorkerPool::parallelFor(size_t begin_, size_t end_, size_t grain_, const RangeFunction & function_) {
+        if (begin_ >= end_)
+          return;
+        grain_ = std::max<size_t>(grain_, 1);
+
+        // Split the range into chunks - a few per worker, so stealing can balance the load.
+        size_t size = end_ - begin_;
+        size_t max_chunks = 4 * (queues.size() + 1);
+        size_t chunk = std::max(grain_, (size + max_chunks - 1) / max_chunks);
+        size_t number_of_tasks = (size + chunk - 1) / chunk;
+
+        // Not worth (or nobody to) distribute.
+        if ((number_of_tasks == 1) || queues.empty()) {
+          function_(begin_, end_);
+          return;
+        }//: if
+
+        Call call;
+        call.pending = number_of_tasks;
+        {
+          boost::mutex::scoped_lock lock(wakeup_mutex);
+          queued_tasks += number_of_tasks;
+        }
+        for (size_t i = 0; i < number_of_tasks; i++) {
+          Task task = { &function_, begin_ + i * chunk, std::min(begin_ + (i + 1) * chunk, end_), &call };
+          WorkerQueue& queue = *queues[next_queue++ % queues.size()];
+          boost::mutex::scoped_lock lock(queue.mutex);
+          queue.tasks.push_back(task);
+        }//: for
+        wakeup.notify_all();
+
+        // Help until all tasks of this call are finished.
+        size_t index = next_queue % queues.size();
+        while (call.pending.load(boost::memory_order_acquire) > 0) {
+          if (!executeNextTask(index))
+            boost::this_thread::yield();
+        }//: while
+
+        // Pass the failure of a task to the caller.
+        if (call.exception)
+          std::rethrow_exception(call.exception);
+      }
+
+      bool WorkerPool::executeNextTask(size_t index_) {
+        Task task;
+        bool found = false;
+        // Check own queue first (newest task), then steal from the others (oldest task).
+        for (size_t i = 0; (i < queues.size()) && !found; i++) {
+          WorkerQueue& queue = *queues[(index_ + i) % queues.size()];
+          boost::mutex::scoped_lock lock(queue.mutex);
+          if (queue.tasks.empty())
+            continue;
+          if (i == 0) {
+            task = queue.tasks.back();
+            queue.tasks.pop_back();
+          } else {
+            task = queue.tasks.front();
+            queue.tasks.pop_front();
+          }//: else
+          found = true;
+        }//: for
+        if (!found)
+          return false;
+
+        queued_tasks--;
+        try {
+          (*task.function)(task.begin, task.end);
+        } catch (...) {
+          // Store the first exception - it is rethrown by parallelFor, the worker keeps running.
+          boost::mutex::scoped_lock lock(task.call->mutex);
+          if (!task.call->exception)
+            task.call->exception = std::current_exception();
+        }//: catch
+        // Always finish the task, so the caller of parallelFor does not wait forever.
+        task.call->pending.fetch_sub(1, boost::memory_order_release);
+        return true;
+      }
+
+      void WorkerPool::workerLoop(size_t index_) {
+        while (!terminate) {
+          if (executeNextTask(index_))
+            continue;
+          // Sleep until new tasks arrive.
+          boost::mutex::scoped_lock lock(wakeup_mutex);
+          while ((queued_tasks == 0) && !terminate)
+            wakeup.wait(lock);
+        }//: while
+      }
+
+    } /* namespace visualization */
+  } /* namespace opengl */
+} /* namespace mic */
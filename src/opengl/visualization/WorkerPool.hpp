@@ -0,0 +1,191 @@
+/*!
+ * Copyright (C) tkornuta, IBM Corporation 2015-2019
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file WorkerPool.hpp
+ * \brief Declaration of WorkerPool class - a work-stealing pool of threads preparing data of windows.
+ * \author tkornuta
+ * \date Oct 18, 2026
+ */
+
+#ifndef SRC_OPENGL_VISUALIZATION_WORKERPOOL_HPP_
+#define SRC_OPENGL_VISUALIZATION_WORKERPOOL_HPP_
+
+#include <boost/atomic.hpp>
+#include <boost/function.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/thread.hpp>
+
+#include <deque>
+#include <exception>
+#include <memory>
+#include <vector>
+
+namespace mic {
+  namespace opengl {
+    namespace visualization {
+
+      /*!
+       * \brief Work-stealing pool of threads shared by all windows, used for preparing frame data (reductions, colorization, packing of textures) in parallel.
+       *
+       * Every worker has its own queue of tasks: it executes its own tasks in LIFO order and steals the oldest tasks of other workers when its queue is empty.
+       * The thread calling parallelFor() does not sleep - it executes (steals) tasks as well until all tasks of the call are done, so calls can also be nested.
+       * Defined in the form of a singleton, with double-checked locking pattern (DCLP) based access to instance.
+       * \author tkornuta
+       */
+      class WorkerPool {
+      public:
+
+        /*!
+         * Type of function processing a range of indices [begin, end).
+         */
+        typedef boost::function<void (size_t, size_t)> RangeFunction;
+
+        /*!
+         * Virtual destructor. Stops and joins the workers.
+         */
+        virtual ~WorkerPool();
+
+        /*!
+         * Method for accessing the object instance, with double-checked locking optimization.
+         * @return Instance of the WorkerPool singleton.
+         */
+        static WorkerPool* getInstance();
+
+        /*!
+         * Splits range of indices into chunks and processes them in parallel. Returns when all chunks are processed.
+         * @param begin_ First index.
+         * @param end_ Index after the last one.
+         * @param grain_ Min number of indices processed by a single task.
+         * @param function_ Function processing a range of indices - must be safe to call concurrently for disjoint ranges.
+         * If the function throws, the remaining tasks are still executed and the first exception is rethrown once all of them are finished.
+         */
+        void parallelFor(size_t begin_, size_t end_, size_t grain_, const RangeFunction & function_);
+
+        /*!
+         * Returns number of worker threads (not counting the calling thread).
+         */
+        size_t getNumberOfWorkers() const { return queues.size(); }
+
+        /// Min number of elements (e.g. values or pixels) worth processing by a single task - smaller chunks are not worth distributing.
+        static const size_t min_elements_per_task = 65536;
+
+      private:
+        /*!
+         * \brief Structure storing state of a single parallelFor call, shared by its tasks.
+         */
+        struct Call {
+          /// Counter of unfinished tasks.
+          boost::atomic<size_t> pending;
+
+          /// Mutex protecting the exception.
+          boost::mutex mutex;
+
+          /// The first exception thrown by a task.
+          std::exception_ptr exception;
+        };
+
+        /*!
+         * \brief Structure representing a single task - a chunk of range processed by a given function.
+         */
+        struct Task {
+          /// Processing function (owned by the caller of parallelFor).
+          const RangeFunction* function;
+
+          /// First index of the chunk.
+          size_t begin;
+
+          /// Index after the last one.
+          size_t end;
+
+          /// State of the parallelFor call the task belongs to.
+          Call* call;
+        };
+
+        /*!
+         * \brief Queue of tasks of a single worker.
+         */
+        struct WorkerQueue {
+          /// Mutex protecting the queue.
+          boost::mutex mutex;
+
+          /// Tasks.
+          std::deque<Task> tasks;
+        };
+
+        /*!
+         * Private instance - accessed as atomic operation.
+         */
+        static boost::atomic<WorkerPool*> instance_;
+
+        /*!
+         * Mutex used for instantiation of the instance.
+         */
+        static boost::mutex instantiation_mutex;
+
+        /*!
+         * Private constructor. Starts the workers.
+         */
+        WorkerPool();
+
+        /*!
+         * Main loop of a worker.
+         * @param index_ Index of the worker.
+         */
+        void workerLoop(size_t index_);
+
+        /*!
+         * Takes a task from own queue (newest one) or steals it from other queues (oldest one) and executes it.
+         * @param index_ Index of the queue checked first.
+         * @return True if a task was executed.
+         */
+        bool executeNextTask(size_t index_);
+
+        /// Queues of the workers.
+        std::vector<std::shared_ptr<WorkerQueue> > queues;
+
+        /// Worker threads.
+        boost::thread_group workers;
+
+        /// Number of tasks waiting in queues.
+        boost::atomic<size_t> queued_tasks;
+
+        /// Flag informing workers that they should terminate.
+        boost::atomic<bool> terminate;
+
+        /// Mutex used by sleeping workers.
+        boost::mutex wakeup_mutex;
+
+        /// Condition variable waking up workers when new tasks arrive.
+        boost::condition_variable wakeup;
+
+        /// Queue the next task will be pushed to.
+        boost::atomic<size_t> next_queue;
+      };
+
+
+      /*!
+       * \brief Macro returning worker pool instance.
+       * \author tkornuta
+       */
+#define VGL_WORKER_POOL mic::opengl::visualization::WorkerPool::getInstance()
+
+
+    } /* namespace visualization */
+  } /* namespace opengl */
+} /* namespace mic */
+
+#endif /* SRC_OPENGL_VISUALIZATION_WORKERPOOL_HPP_ */